@@ -42,6 +42,28 @@ const char LOG_TO_STR[] = "Log To: ";
 const char LOG_PATH_STR[] = "Log File Path: ";
 const char CONFIG_END_LN[] = "End Simulator Configuration File.";
 
+// Optional lines, allowed in any order between Log File Path and the end
+// CPU Count splits a non-preemptive schedule across CPUs before any of
+// them starts, preemptive schedules run on one CPU whatever it says
+const char CPU_COUNT_STR[] = "CPU Count: ";
+const char MLFQ_LEVELS_STR[] = "MLFQ Levels: ";
+const char MLFQ_BOOST_STR[] = "MLFQ Boost Interval (msec): ";
+const char METRICS_PATH_STR[] = "Metrics File Path: ";
+const char VIRTUAL_TIME_STR[] = "Virtual Time: ";
+const char RECORD_PATH_STR[] = "Interrupt Record Path: ";
+const char REPLAY_PATH_STR[] = "Interrupt Replay Path: ";
+const char CHECKPOINT_INTERVAL_STR[] = "Checkpoint Interval (msec): ";
+const char CHECKPOINT_PATH_STR[] = "Checkpoint File Path: ";
+const char INT_BATCH_SIZE_STR[] = "Interrupt Batch Size: ";
+const char INT_BATCH_DELAY_STR[] = "Interrupt Batch Delay (cycles): ";
+const char PAGE_SIZE_STR[] = "Page Size (KB): ";
+const char TLB_ENTRIES_STR[] = "TLB Entries: ";
+const char TLB_WAYS_STR[] = "TLB Ways: ";
+const char PAGE_FAULT_STR[] = "Page Fault Time (cycles): ";
+const char ALLOCATOR_STR[] = "Memory Allocator: ";
+const char SWAP_PATH_STR[] = "Swap File Path: ";
+const char SWAP_TIME_STR[] = "Swap Time (cycles): ";
+
 // Configuration Schedule Codes
 const char NONE[] = "NONE";
 const char FCFS_N[] = "FCFS-N";
@@ -49,11 +71,34 @@ const char SJF_N[] = "SJF-N";
 const char SRTF_P[] = "SRTF-P";
 const char FCFS_P[] = "FCFS-P";
 const char RR_P[] = "RR-P";
+const char MLFQ_P[] = "MLFQ-P";
+const char STRIDE_P[] = "STRIDE-P";
 
 //Configuration LogTo Option
 const char MONITOR[] = "Monitor";
 const char LOG_TO_FILE[] = "File";
 const char BOTH[] = "Both";
+const char LOG_TO_NONE[] = "None";
+
+// Virtual Time Option
+const char VIRTUAL_ON[] = "On";
+const char VIRTUAL_OFF[] = "Off";
+
+// Memory Allocator Option
+const char ALLOC_FIXED[] = "Fixed";
+const char ALLOC_BUDDY[] = "Buddy";
+
+// Config fields that can be set by name, and the line each is read from
+const char *CONFIG_FIELD_NAMES[] = { "version", "scheduleCode",
+    "quantumTime", "memorySize", "pCycleTime", "ioCycleTime", "cpuCount",
+    "mlfqLevels", "mlfqBoostTime", "virtualTime", "intBatchSize",
+    "intBatchDelay", "pageSize", "tlbEntries", "tlbWays",
+    "pageFaultCycles", "memAllocator", "swapCycles", NULL };
+const char *CONFIG_FIELD_TITLES[] = { VERSION_STR, CPU_SCHD_STR,
+    QUANTUM_TIME_STR, MEMORY_STR, PROCESSOR_STR, IO_STR, CPU_COUNT_STR,
+    MLFQ_LEVELS_STR, MLFQ_BOOST_STR, VIRTUAL_TIME_STR, INT_BATCH_SIZE_STR,
+    INT_BATCH_DELAY_STR, PAGE_SIZE_STR, TLB_ENTRIES_STR, TLB_WAYS_STR,
+    PAGE_FAULT_STR, ALLOCATOR_STR, SWAP_TIME_STR, NULL };
 
 const int STD_CONFIG_STR = 50;
 //
@@ -92,6 +137,8 @@ int parseConfig( FILE *config, Config *configData )
 {
     char *inLine = malloc( STD_CONFIG_STR );
 
+    setConfigDefaults( configData );
+
     if( validateLine( config, configData, inLine, CONFIG_START_LN, 0 ) ==
             MISMATCH_STR )
     {
@@ -162,8 +209,7 @@ int parseConfig( FILE *config, Config *configData )
         return INVALID_CONFIG_FILE;
     }
 
-    if( validateLine( config, configData, inLine, CONFIG_END_LN, 0 ) ==
-            MISMATCH_STR )
+    if( parseOptionalLines( config, configData, inLine ) != NO_ERROR_MSG )
     {
         free( inLine );
         return INVALID_CONFIG_FILE;
@@ -448,7 +494,9 @@ int validateScheduleCode( char* scheduleCode, Config *configData )
             stringCompare( scheduleCode, SJF_N ) == NO_ERROR_MSG ||
             stringCompare( scheduleCode, SRTF_P ) == NO_ERROR_MSG ||
             stringCompare( scheduleCode, FCFS_P ) == NO_ERROR_MSG ||
-            stringCompare( scheduleCode, RR_P ) == NO_ERROR_MSG )
+            stringCompare( scheduleCode, RR_P ) == NO_ERROR_MSG ||
+            stringCompare( scheduleCode, MLFQ_P ) == NO_ERROR_MSG ||
+            stringCompare( scheduleCode, STRIDE_P ) == NO_ERROR_MSG )
     {
         copyString( configData->scheduleCode, scheduleCode );
     }
@@ -480,7 +528,8 @@ int validateLogTo( char* logTo, Config *configData )
 {
     if( stringCompare( logTo, MONITOR ) == NO_ERROR_MSG ||
         stringCompare( logTo, LOG_TO_FILE ) == NO_ERROR_MSG ||
-        stringCompare( logTo, BOTH ) == NO_ERROR_MSG )
+        stringCompare( logTo, BOTH ) == NO_ERROR_MSG ||
+        stringCompare( logTo, LOG_TO_NONE ) == NO_ERROR_MSG )
     {
         copyString( configData->logTo, logTo );
     }
@@ -491,6 +540,357 @@ int validateLogTo( char* logTo, Config *configData )
     return NO_ERROR_MSG;
 }
 
+//==========================================================================
+/**
+* @brief Function sets every optional Config field to its default
+*
+* @details Optional configuration lines may be left out of the file, so
+*   the fields they fill start at values that keep the simulator's
+*   original behavior.
+*
+* @param[in] configData
+* A Config struct pointer to fill with defaults
+*/
+void setConfigDefaults( Config *configData )
+{
+    configData->cpuCount = 1;
+    configData->mlfqLevels = 3;
+    configData->mlfqBoostTime = 500;
+    configData->metricsFilePath[ 0 ] = NUL;
+    configData->virtualTime = 0;
+    configData->recordFilePath[ 0 ] = NUL;
+    configData->replayFilePath[ 0 ] = NUL;
+    configData->checkpointInterval = 0;
+    copyString( configData->checkpointFilePath, "sim04.ckpt" );
+    configData->intBatchSize = 1;
+    configData->intBatchDelay = 0;
+    configData->pageSize = 0;
+    configData->tlbEntries = 16;
+    configData->tlbWays = 4;
+    configData->pageFaultCycles = 100;
+    configData->buddyAllocator = 0;
+    configData->swapFilePath[ 0 ] = NUL;
+    configData->swapCycles = 10;
+}
+
+//==========================================================================
+/**
+* @brief Function reads optional configuration lines up to the end line
+*
+* @details Function reads each line after Log File Path. The end line
+*   finishes parsing, any other line must be a known "Title: value" pair.
+*
+* @par Algorithm
+*   Function gets the next line and trims it. If it is the end line, it
+*   returns no error. Otherwise it splits the line after the ": " that
+*   ends the title and passes both halves to storeOption(). Running out
+*   of file before the end line is an error.
+*
+* @param[in] file
+* points to the open file handle for the configuration file
+*
+* @param[in] configData
+* points to the struct in memory to hold configuration data
+*
+* @param[in] fileData
+* points to the string in memory to hold each configuration file line
+*
+* @return no error if the end line was reached and every optional line
+*   was valid, mismatch string otherwise
+*/
+int parseOptionalLines( FILE *file, Config *configData, char *fileData )
+{
+    char titleStr[STD_CONFIG_STR];
+    char data[STD_CONFIG_STR];
+    char *line;
+    int index;
+
+    while( fgets( fileData, STD_CONFIG_STR, file ) != NULL )
+    {
+        line = trimWhiteSpace( fileData );
+
+        if( stringCompare( line, CONFIG_END_LN ) == NO_ERROR_MSG )
+        {
+            return NO_ERROR_MSG;
+        }
+
+        index = 0;
+        while( line[ index ] != NUL &&
+               !( line[ index ] == ':' && line[ index + 1 ] == SPACE ) )
+        {
+            index++;
+        }
+        if( line[ index ] == NUL )
+        {
+            return MISMATCH_STR;
+        }
+
+        splitString( line, titleStr, data, index + 2 );
+        if( storeOption( titleStr, data, configData ) != NO_ERROR_MSG )
+        {
+            return MISMATCH_STR;
+        }
+    }
+    return MISMATCH_STR;
+}
+
+//==========================================================================
+/**
+* @brief Function validates and stores the value of one optional line
+*
+* @details Function finds which optional field the title names, checks
+*   the value is within that field's constraints and stores it.
+*
+* @param[in] titleStr
+* array holding the title of the line, including the ": "
+*
+* @param[in] data
+* array holding the value of the line
+*
+* @param[in] configData
+* points to the Config type struct in memory that holds all configuration
+*   data.
+*
+* @return no error if stored, invalid data if the value is out of range,
+*   mismatch string if the title is not a known option
+*/
+int storeOption( char titleStr[], char data[], Config *configData )
+{
+    int value = stringToInt( data );
+
+    if( stringCompare( titleStr, CPU_COUNT_STR ) == NO_ERROR_MSG )
+    {
+        if( 1 <= value && value <= 64 )
+        {
+            configData->cpuCount = value;
+        }
+        else
+        {
+            return INVALID_DATA;
+        }
+    }
+    else if( stringCompare( titleStr, MLFQ_LEVELS_STR ) == NO_ERROR_MSG )
+    {
+        if( 1 <= value && value <= 16 )
+        {
+            configData->mlfqLevels = value;
+        }
+        else
+        {
+            return INVALID_DATA;
+        }
+    }
+    else if( stringCompare( titleStr, METRICS_PATH_STR ) == NO_ERROR_MSG )
+    {
+        copyString( configData->metricsFilePath, data );
+    }
+    else if( stringCompare( titleStr, RECORD_PATH_STR ) == NO_ERROR_MSG )
+    {
+        copyString( configData->recordFilePath, data );
+    }
+    else if( stringCompare( titleStr, REPLAY_PATH_STR ) == NO_ERROR_MSG )
+    {
+        copyString( configData->replayFilePath, data );
+    }
+    else if( stringCompare( titleStr, CHECKPOINT_INTERVAL_STR )
+             == NO_ERROR_MSG )
+    {
+        // zero checkpoints only when signalled
+        if( 0 <= value && value <= 86400000 )
+        {
+            configData->checkpointInterval = value;
+        }
+        else
+        {
+            return INVALID_DATA;
+        }
+    }
+    else if( stringCompare( titleStr, CHECKPOINT_PATH_STR ) == NO_ERROR_MSG )
+    {
+        copyString( configData->checkpointFilePath, data );
+    }
+    else if( stringCompare( titleStr, INT_BATCH_SIZE_STR ) == NO_ERROR_MSG )
+    {
+        if( 1 <= value && value <= 1000 )
+        {
+            configData->intBatchSize = value;
+        }
+        else
+        {
+            return INVALID_DATA;
+        }
+    }
+    else if( stringCompare( titleStr, INT_BATCH_DELAY_STR ) == NO_ERROR_MSG )
+    {
+        // zero delivers interrupts as soon as they are due
+        if( 0 <= value && value <= 100000 )
+        {
+            configData->intBatchDelay = value;
+        }
+        else
+        {
+            return INVALID_DATA;
+        }
+    }
+    else if( stringCompare( titleStr, PAGE_SIZE_STR ) == NO_ERROR_MSG )
+    {
+        // zero leaves memory in segments, unpaged
+        if( 0 <= value && value <= 1048576 )
+        {
+            configData->pageSize = value;
+        }
+        else
+        {
+            return INVALID_DATA;
+        }
+    }
+    else if( stringCompare( titleStr, TLB_ENTRIES_STR ) == NO_ERROR_MSG )
+    {
+        if( 1 <= value && value <= 4096 )
+        {
+            configData->tlbEntries = value;
+        }
+        else
+        {
+            return INVALID_DATA;
+        }
+    }
+    else if( stringCompare( titleStr, TLB_WAYS_STR ) == NO_ERROR_MSG )
+    {
+        if( 1 <= value && value <= 4096 )
+        {
+            configData->tlbWays = value;
+        }
+        else
+        {
+            return INVALID_DATA;
+        }
+    }
+    else if( stringCompare( titleStr, PAGE_FAULT_STR ) == NO_ERROR_MSG )
+    {
+        if( 0 <= value && value <= 100000 )
+        {
+            configData->pageFaultCycles = value;
+        }
+        else
+        {
+            return INVALID_DATA;
+        }
+    }
+    else if( stringCompare( titleStr, MLFQ_BOOST_STR ) == NO_ERROR_MSG )
+    {
+        // zero turns the periodic boost off
+        if( 0 <= value && value <= 100000 )
+        {
+            configData->mlfqBoostTime = value;
+        }
+        else
+        {
+            return INVALID_DATA;
+        }
+    }
+    else if( stringCompare( titleStr, VIRTUAL_TIME_STR ) == NO_ERROR_MSG )
+    {
+        if( stringCompare( data, VIRTUAL_ON ) == NO_ERROR_MSG )
+        {
+            configData->virtualTime = 1;
+        }
+        else if( stringCompare( data, VIRTUAL_OFF ) == NO_ERROR_MSG )
+        {
+            configData->virtualTime = 0;
+        }
+        else
+        {
+            return INVALID_DATA;
+        }
+    }
+    else if( stringCompare( titleStr, SWAP_PATH_STR ) == NO_ERROR_MSG )
+    {
+        copyString( configData->swapFilePath, data );
+    }
+    else if( stringCompare( titleStr, SWAP_TIME_STR ) == NO_ERROR_MSG )
+    {
+        if( 0 <= value && value <= 100000 )
+        {
+            configData->swapCycles = value;
+        }
+        else
+        {
+            return INVALID_DATA;
+        }
+    }
+    else if( stringCompare( titleStr, ALLOCATOR_STR ) == NO_ERROR_MSG )
+    {
+        // Fixed places allocations where the metadata says
+        if( stringCompare( data, ALLOC_FIXED ) == NO_ERROR_MSG )
+        {
+            configData->buddyAllocator = 0;
+        }
+        else if( stringCompare( data, ALLOC_BUDDY ) == NO_ERROR_MSG )
+        {
+            configData->buddyAllocator = 1;
+        }
+        else
+        {
+            return INVALID_DATA;
+        }
+    }
+    else
+    {
+        return MISMATCH_STR;
+    }
+
+    return NO_ERROR_MSG;
+}
+
+//==========================================================================
+/**
+* @brief Function validates and stores one Config field given by name
+*
+* @details Function looks the field name up in CONFIG_FIELD_NAMES and
+*   stores the value exactly as if it had been read from that field's
+*   line of a configuration file, with the same constraints.
+*
+* @param[in] configData
+* points to the Config type struct in memory that holds all configuration
+*   data.
+*
+* @param[in] fieldName
+* array holding the name of a Config field, such as quantumTime
+*
+* @param[in] value
+* array holding the value as it would be written in the file
+*
+* @return no error if stored, invalid data or mismatch string if the value
+*   is not valid for the field, unknown error if no field has the name
+*/
+int setConfigField( Config *configData, char fieldName[], char value[] )
+{
+    char titleStr[ STD_CONFIG_STR ];
+    int index, status;
+
+    for( index = 0; CONFIG_FIELD_NAMES[ index ] != NULL; index++ )
+    {
+        if( stringCompare( fieldName, CONFIG_FIELD_NAMES[ index ] )
+            == NO_ERROR_MSG )
+        {
+            copyString( titleStr, ( char * )CONFIG_FIELD_TITLES[ index ] );
+
+            status = storeData( titleStr, stringToInt( value ), configData );
+            if( status == UNKNOWN_ERR )
+            {
+                status = storeString( titleStr, value, configData );
+            }
+            if( status == UNKNOWN_ERR )
+            {
+                status = storeOption( titleStr, value, configData );
+            }
+            return status;
+        }
+    }
+    return UNKNOWN_ERR;
+}
+
 //==========================================================================
 // Terminating Precompiler Directives ///////////////////////////////
 //
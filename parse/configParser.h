@@ -36,10 +36,15 @@ extern const char SJF_N[];
 extern const char SRTF_P[];
 extern const char FCFS_P[];
 extern const char RR_P[];
+extern const char MLFQ_P[];
+extern const char STRIDE_P[];
 
 extern const char MONITOR[];
 extern const char LOG_TO_FILE[];
 extern const char BOTH[];
+extern const char LOG_TO_NONE[];
+
+extern const char *CONFIG_FIELD_NAMES[];
 //
 // Data Structure Definitions (structs, enums, etc.)////////////////
 //
@@ -54,6 +59,24 @@ typedef struct Config
     int ioCycleTime;
     char logTo[ 50 ];
     char logFilePath[ 50 ];
+    int cpuCount;
+    int mlfqLevels;
+    int mlfqBoostTime;
+    char metricsFilePath[ 50 ];
+    int virtualTime;
+    char recordFilePath[ 50 ];
+    char replayFilePath[ 50 ];
+    int checkpointInterval;
+    char checkpointFilePath[ 50 ];
+    int intBatchSize;
+    int intBatchDelay;
+    int pageSize;
+    int tlbEntries;
+    int tlbWays;
+    int pageFaultCycles;
+    int buddyAllocator;
+    char swapFilePath[ 50 ];
+    int swapCycles;
 } Config;
 //
 // Free Function Prototypes ///////////////////////////////////////
@@ -86,6 +109,22 @@ int validateScheduleCode( char* scheduleCode, Config *configData );
 
 int validateLogTo( char* logTo, Config *configData );
 
+//==========================================================================
+
+void setConfigDefaults( Config *configData );
+
+//==========================================================================
+
+int parseOptionalLines( FILE *file, Config *configData, char *fileData );
+
+//==========================================================================
+
+int storeOption( char titleStr[], char data[], Config *configData );
+
+//==========================================================================
+
+int setConfigField( Config *configData, char fieldName[], char value[] );
+
 //==========================================================================
 // Terminating Precompiler Directives ///////////////////////////////
 //
@@ -0,0 +1,397 @@
+// PROGRAMMER INFORMATION ////////////////////////////////////////////
+/**
+
+Secret Number: 764819
+
+*/
+// Code Implementation File Information /////////////////////////////
+/**
+* @file batch.c
+*
+* @brief Implementation file for batch code
+*
+* @details Implements all functions of the batch runner
+*/
+// Program Description/Support /////////////////////////////////////
+/*
+This program reads a job file naming one configuration file per line,
+optionally followed by a metadata file to use instead of the one the
+configuration names. A pool of worker threads takes jobs in order and
+runs each as its own simulation: every job parses its own files and
+has its own clock, logs, memory and process list, so nothing is shared
+between them but the index of the next job. Logs go to each job's
+configured log file rather than the monitor. Once all jobs are done, a
+summary of each is printed.
+*/
+// Header Files ///////////////////////////////////////////////////
+//
+#include "batch.h"
+//
+// Global Constant Definitions ////////////////////////////////////
+//
+const char BATCH_FLAG[] = "--batch";
+const char WORKERS_FLAG[] = "-j";
+const int MAX_BATCH_WORKERS = 64;
+//
+// Free Function Prototypes ///////////////////////////////////////
+//
+static void *runBatchWorker( void *runner );
+static void numberSwapFile( Config *configData, int jobIndex );
+//
+//==========================================================================
+/**
+* @brief Function runs every job in a job file on a pool of workers
+*
+* @details The function reads the job file, starts the workers, waits
+*   for them to run every job, then prints the summary.
+*
+* @param[in] jobFileName
+* Path of the job file
+*
+* @param[in] numWorkers
+* Number of jobs to run at once, 1 to MAX_BATCH_WORKERS
+*
+* @return no error message if the jobs ran, the job file error otherwise
+*/
+int runBatch( char *jobFileName, int numWorkers )
+{
+    BatchRunner batch;
+    int status;
+
+    status = readJobFile( jobFileName, &batch );
+    if( status != NO_ERROR_MSG )
+    {
+        return status;
+    }
+
+    runBatchJobs( &batch, numWorkers );
+    printBatchSummary( &batch );
+
+    free( batch.jobs );
+
+    return NO_ERROR_MSG;
+}
+
+//==========================================================================
+/**
+* @brief Function reads the jobs from a job file
+*
+* @details Blank lines and lines starting with # are skipped. Every
+*   other line holds a configuration file path, then optionally a
+*   metadata file path, separated by spaces.
+*
+* @param[in] jobFileName
+* Path of the job file
+*
+* @param[out] batch
+* Receives the jobs read, all not yet run
+*
+* @return no error message if at least one job was read, file not found
+*   or invalid data otherwise
+*/
+int readJobFile( char *jobFileName, BatchRunner *batch )
+{
+    FILE *jobFile = openFile( jobFileName );
+    char line[ 256 ];
+    int capacity = 16;
+    BatchJob *job;
+
+    if( jobFile == NULL )
+    {
+        return FILE_NOT_FOUND_ERR;
+    }
+
+    batch->jobs = malloc( sizeof( BatchJob ) * capacity );
+    batch->numJobs = 0;
+
+    while( fgets( line, sizeof( line ), jobFile ) != NULL )
+    {
+        if( batch->numJobs == capacity )
+        {
+            capacity *= 2;
+            batch->jobs = realloc( batch->jobs,
+                                   sizeof( BatchJob ) * capacity );
+        }
+
+        job = &batch->jobs[ batch->numJobs ];
+        job->metadataPath[ 0 ] = NUL;
+
+        if( sscanf( line, "%99s %99s", job->configPath,
+                    job->metadataPath ) < 1 ||
+            job->configPath[ 0 ] == '#' )
+        {
+            continue;
+        }
+
+        job->mdList = NULL;
+        job->status = UNKNOWN_ERR;
+        job->result.processes = 0;
+        job->result.makespan = 0.0;
+        job->result.meanTurnaround = 0.0;
+        job->result.meanResponse = 0.0;
+        job->result.cpuUtilization = 0.0;
+        job->result.segFaults = 0;
+        batch->numJobs++;
+    }
+    closeFile( jobFile );
+
+    if( batch->numJobs == 0 )
+    {
+        free( batch->jobs );
+        return INVALID_DATA;
+    }
+    return NO_ERROR_MSG;
+}
+
+//==========================================================================
+/**
+* @brief Function runs every job on a pool of workers
+*
+* @details The function starts the workers, no more than there are jobs,
+*   and returns once they have run every job.
+*
+* @param[in] batch
+* A BatchRunner pointer holding the jobs, each job's status and result
+*   are set
+*
+* @param[in] numWorkers
+* Number of jobs to run at once
+*/
+void runBatchJobs( BatchRunner *batch, int numWorkers )
+{
+    pthread_t *workers;
+    int index;
+
+    if( numWorkers > batch->numJobs )
+    {
+        numWorkers = batch->numJobs;
+    }
+
+    batch->nextJob = 0;
+    pthread_mutex_init( &batch->lock, NULL );
+    workers = malloc( sizeof( pthread_t ) * ( numWorkers + 1 ) );
+
+    for( index = 0; index < numWorkers; index++ )
+    {
+        pthread_create( &workers[ index ], NULL, runBatchWorker, batch );
+    }
+    for( index = 0; index < numWorkers; index++ )
+    {
+        pthread_join( workers[ index ], NULL );
+    }
+
+    pthread_mutex_destroy( &batch->lock );
+    free( workers );
+}
+
+//==========================================================================
+/**
+* @brief Function takes jobs until none are left, running each in turn
+*
+* @param[in] runner
+* A BatchRunner pointer
+*
+* @return NULL
+*/
+static void *runBatchWorker( void *runner )
+{
+    BatchRunner *batch = ( BatchRunner * )( runner );
+    int jobIndex;
+
+    while( 1 )
+    {
+        pthread_mutex_lock( &batch->lock );
+        jobIndex = batch->nextJob;
+        if( jobIndex < batch->numJobs )
+        {
+            batch->nextJob++;
+        }
+        pthread_mutex_unlock( &batch->lock );
+
+        if( jobIndex >= batch->numJobs )
+        {
+            break;
+        }
+        runBatchJob( &batch->jobs[ jobIndex ], jobIndex );
+    }
+    return NULL;
+}
+
+//==========================================================================
+/**
+* @brief Function runs one job as a simulation of its own
+*
+* @details A job with its metadata already parsed is simply run. Any
+*   other job parses its configuration file and its metadata file, then
+*   runs the simulator on them. Logging to the monitor is turned into
+*   logging to the configured log file, so jobs running at once do not
+*   mix their lines with each other and with the summary. A job that
+*   logs nowhere still does. Checkpoints are turned off, since SIGUSR1 is
+*   not caught in a batch and jobs could write over each other's file.
+*   Each job swaps to a file of its own.
+*
+* @param[in] job
+* A BatchJob pointer, its status and result are set
+*
+* @param[in] jobIndex
+* The job's place in the batch, counted from 0
+*/
+void runBatchJob( BatchJob *job, int jobIndex )
+{
+    FILE *configFile;
+    FILE *metaFile;
+    Config configData;
+    MetadataList *mdList;
+
+    if( job->mdList != NULL )
+    {
+        numberSwapFile( &job->configData, jobIndex );
+        runSimulator( job->mdList, &job->configData, &job->result );
+        job->status = NO_ERROR_MSG;
+        return;
+    }
+
+    configFile = openFile( job->configPath );
+    if( configFile == NULL )
+    {
+        job->status = FILE_NOT_FOUND_ERR;
+        return;
+    }
+
+    if( parseConfig( configFile, &configData ) == INVALID_CONFIG_FILE )
+    {
+        closeFile( configFile );
+        job->status = INVALID_CONFIG_FILE;
+        return;
+    }
+    closeFile( configFile );
+
+    if( job->metadataPath[ 0 ] != NUL )
+    {
+        if( stringLength( job->metadataPath ) >=
+            ( int )sizeof( configData.metadataFilePath ) )
+        {
+            job->status = INVALID_DATA;
+            return;
+        }
+        copyString( configData.metadataFilePath, job->metadataPath );
+    }
+
+    metaFile = openFile( configData.metadataFilePath );
+    if( metaFile == NULL )
+    {
+        job->status = FILE_NOT_FOUND_ERR;
+        return;
+    }
+
+    mdList = mdListCreate();
+    if( parseMetadata( metaFile, mdList ) == INVALID_METADATA_FILE )
+    {
+        closeFile( metaFile );
+        mdListDestroy( mdList );
+        job->status = INVALID_METADATA_FILE;
+        return;
+    }
+    closeFile( metaFile );
+
+    if( stringCompare( configData.logTo, LOG_TO_NONE ) != 0 )
+    {
+        copyString( configData.logTo, ( char * )LOG_TO_FILE );
+    }
+    configData.checkpointInterval = 0;
+    numberSwapFile( &configData, jobIndex );
+    runSimulator( mdList, &configData, &job->result );
+    job->status = NO_ERROR_MSG;
+
+    mdListDestroy( mdList );
+}
+
+//==========================================================================
+/**
+* @brief Function puts the job's number on the end of its swap file path
+*
+* @details Jobs running at once would otherwise share one swap file, each
+*   writing over the others' pages and removing it as it ends. The path
+*   is cut short if the number would not fit.
+*
+* @param[in] configData
+* A pointer to the job's Config struct, its swap file path is changed
+*
+* @param[in] jobIndex
+* The job's place in the batch, counted from 0
+*/
+static void numberSwapFile( Config *configData, int jobIndex )
+{
+    char number[ 20 ];
+    int pathSize = ( int )sizeof( configData->swapFilePath );
+    int keep;
+
+    if( configData->swapFilePath[ 0 ] == NUL )
+    {
+        return;
+    }
+
+    snprintf( number, sizeof( number ), ".%d", jobIndex + 1 );
+    keep = pathSize - 1 - stringLength( number );
+    if( stringLength( configData->swapFilePath ) > keep )
+    {
+        configData->swapFilePath[ keep ] = NUL;
+    }
+    copyString( &configData->swapFilePath[
+                    stringLength( configData->swapFilePath ) ], number );
+}
+
+//==========================================================================
+/**
+* @brief Function prints one row per job and how many jobs ran
+*
+* @details Times are milliseconds from each job's System Start. Jobs
+*   that could not run show why in place of their results.
+*
+* @param[in] batch
+* A BatchRunner pointer, every job run
+*/
+void printBatchSummary( BatchRunner *batch )
+{
+    BatchJob *job;
+    int index, completed = 0;
+
+    printf( "Batch Summary\n" );
+    printf( "====================\n" );
+    printf( "Job  Procs  Makespan  Turnaround  Response   CPU%%  Config\n" );
+
+    for( index = 0; index < batch->numJobs; index++ )
+    {
+        job = &batch->jobs[ index ];
+
+        if( job->status == NO_ERROR_MSG )
+        {
+            printf( "%3d  %5d  %8.1f  %10.1f  %8.1f  %5.1f  %s\n",
+                    index + 1, job->result.processes, job->result.makespan,
+                    job->result.meanTurnaround, job->result.meanResponse,
+                    job->result.cpuUtilization, job->configPath );
+            completed++;
+        }
+        else
+        {
+            printf( "%3d  %-39s  %s\n", index + 1,
+                    job->status == FILE_NOT_FOUND_ERR ?
+                        "===ERR: FILE NOT FOUND===" :
+                    job->status == INVALID_CONFIG_FILE ?
+                        "===ERR: INVALID CONFIGURATION FILE===" :
+                    job->status == INVALID_METADATA_FILE ?
+                        "===ERR: INVALID METADATA FILE===" :
+                        "===ERR: INVALID JOB===",
+                    job->configPath );
+        }
+    }
+
+    printf( "====================\n" );
+    printf( "%d of %d jobs completed\n", completed, batch->numJobs );
+}
+
+//==========================================================================
+// Terminating Precompiler Directives ///////////////////////////////
+//
+///// NONE
+//
@@ -0,0 +1,94 @@
+// PROGRAMMER INFORMATION ////////////////////////////////////////////
+/**
+
+Secret Number: 764819
+
+*/
+// Header File Information /////////////////////////////////////
+/**
+* @file batch.h
+*
+* @brief Header file for batch code
+*
+* @details Specifies functions, constants, and other information
+* related to running many simulations at once from a job file
+*/
+// Precompiler Directives //////////////////////////////////////////
+//
+#ifndef BATCH_H
+#define BATCH_H
+//
+// Header Files ///////////////////////////////////////////////////
+//
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "configParser.h"
+#include "metadataParser.h"
+#include "metadataList.h"
+#include "utilities.h"
+#include "simulator.h"
+//
+// Global Constant Definitions ////////////////////////////////////
+//
+extern const char BATCH_FLAG[];
+extern const char WORKERS_FLAG[];
+extern const int MAX_BATCH_WORKERS;
+//
+// Data Structure Definitions (structs, enums, etc.)////////////////
+//
+/*
+  One simulation to run. A job from the job file names a configuration
+  file and, optionally, a metadata file to use in place of the one it
+  names, and parses both itself. A job given its configuration and a
+  parsed metadata list up front, as the sweep does, runs them as they
+  are; the list is only read, so jobs may share it. status is an
+  ERR_CODES value, NO_ERROR_MSG once the simulation has run.
+*/
+typedef struct BatchJob
+{
+    char configPath[ 100 ];
+    char metadataPath[ 100 ];
+    Config configData;
+    MetadataList *mdList;
+    int status;
+    SimResult result;
+} BatchJob;
+
+/*
+  The jobs and the index of the next one not yet taken by a worker
+*/
+typedef struct BatchRunner
+{
+    BatchJob *jobs;
+    int numJobs;
+    int nextJob;
+    pthread_mutex_t lock;
+} BatchRunner;
+//
+// Free Function Prototypes ///////////////////////////////////////
+//
+//==========================================================================
+
+int runBatch( char *jobFileName, int numWorkers );
+
+//==========================================================================
+
+int readJobFile( char *jobFileName, BatchRunner *batch );
+
+//==========================================================================
+
+void runBatchJobs( BatchRunner *batch, int numWorkers );
+
+//==========================================================================
+
+void runBatchJob( BatchJob *job, int jobIndex );
+
+//==========================================================================
+
+void printBatchSummary( BatchRunner *batch );
+
+// Terminating Precompiler Directives ///////////////////////////////
+//
+#endif // BATCH_H
+//
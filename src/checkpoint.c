@@ -0,0 +1,650 @@
+// PROGRAMMER INFORMATION ////////////////////////////////////////////
+/**
+
+Secret Number: 764819
+
+*/
+// Code Implementation File Information /////////////////////////////
+/**
+* @file checkpoint.c
+*
+* @brief Implementation file for checkpoint code
+*
+* @details Implements all functions of simulator checkpoints
+*/
+// Program Description/Support /////////////////////////////////////
+/*
+A checkpoint is written between dispatches, when no process is running.
+It holds everything needed to carry the run on: the configuration, the
+metadata, every PCB with its place in its program, the order of the
+Blocked PCBs and of the policy's ready structure, the memory allocations,
+the log so far and the clock. An I/O is charged to its PCB as it starts,
+so a Blocked PCB only needs the time its I/O ends for the interrupt to be
+posted again. The file is binary and only read back by the same build.
+It is written beside its path and renamed over it, so a crash while
+writing leaves the last checkpoint whole.
+*/
+// Header Files ///////////////////////////////////////////////////
+//
+#include "checkpoint.h"
+//
+// Global Constant Definitions ////////////////////////////////////
+//
+const char RESUME_FLAG[] = "--resume";
+const char CHECKPOINT_MAGIC[] = "SIM04CKP";
+const int CHECKPOINT_VERSION = 5;
+
+// set from the signal handler, read between dispatches
+static volatile sig_atomic_t checkpointSignalled = 0;
+//
+// Free Function Prototypes ///////////////////////////////////////
+//
+static void onCheckpointSignal( int signum );
+static int writeString( FILE *file, char *str );
+static int readString( FILE *file, char *str, int size );
+static int nodeIndex( MetadataList *mdList, MetadataNode *node );
+static int readPCBs( FILE *file, ProcessList *procList,
+                     MetadataNode **nodes, int numNodes );
+static int readStateOrder( FILE *file, ProcessList *procList,
+                           PROC_STATE state );
+//
+//==========================================================================
+/**
+* @brief Function has SIGUSR1 ask for a checkpoint
+*
+* @details Only a single simulation installs this, a batch would have
+*   every job write to its own file at once.
+*/
+void installCheckpointSignal( void )
+{
+    signal( SIGUSR1, onCheckpointSignal );
+}
+
+//==========================================================================
+/**
+* @brief Function notes that a checkpoint was asked for
+*
+* @param[in] signum
+* The signal received
+*/
+static void onCheckpointSignal( int signum )
+{
+    checkpointSignalled = 1;
+    signal( signum, onCheckpointSignal );
+}
+
+//==========================================================================
+/**
+* @brief Function returns whether a checkpoint should be written now
+*
+* @details A checkpoint is due once signalled for, or once the configured
+*   interval has passed since the last one. A signalled checkpoint does
+*   not move the next interval's.
+*
+* @param[in] configData
+* A Config struct pointer
+*
+* @param[in] currTime
+* The current time in seconds
+*
+* @param[in] nextCheckpoint
+* When the next interval's checkpoint is due, moved on past currTime once
+*   it is written
+*
+* @return 1 if a checkpoint is due, 0 otherwise
+*/
+int checkpointDue( Config *configData, double currTime,
+                   double *nextCheckpoint )
+{
+    if( checkpointSignalled )
+    {
+        checkpointSignalled = 0;
+        return 1;
+    }
+
+    if( configData->checkpointInterval > 0 && currTime >= *nextCheckpoint )
+    {
+        while( *nextCheckpoint <= currTime )
+        {
+            *nextCheckpoint += configData->checkpointInterval / 1000.0;
+        }
+        return 1;
+    }
+    return 0;
+}
+
+//==========================================================================
+/**
+* @brief Function writes the state of a simulation to a checkpoint file
+*
+* @details Function must be called between dispatches, with no process
+*   running.
+*
+* @par Algorithm
+*   Function writes, in order: the magic string and version, the Config,
+*   whether the clock is virtual and its time, the metadata nodes, one
+*   CheckpointPCB per PCB, the Blocked PIDs oldest first, the Ready PIDs
+*   in the scheduler's ready order, the total memory and allocations,
+*   then every log line. Strings are written as a length and their
+*   characters.
+*
+* @param[in] checkpointPath
+* Path of the checkpoint file
+*
+* @param[in] sched
+* The Scheduler of the running simulation
+*
+* @param[in] mmu
+* The MMUList of the running simulation
+*
+* @return no error message if written, open file fail otherwise
+*/
+int writeCheckpoint( char *checkpointPath, Scheduler *sched, MMUList *mmu )
+{
+    ProcessList *procList = sched->procList;
+    LogList *logList = sched->logList;
+    ProcessControlBlock **order;
+    ProcessControlBlock *currBlock;
+    MetadataNode *currOp;
+    MMUNode *alloc;
+    LogNode *currLog;
+    CheckpointPCB record;
+    char tmpPath[ 60 ];
+    char timeStr[ 20 ];
+    double currTime = accessTimer( &logList->clock, LAP_TIMER, timeStr );
+    int count, index, virtualTime = logList->clock.virtualTime == True;
+    int written = 1;
+    FILE *file;
+
+    snprintf( tmpPath, sizeof( tmpPath ), "%s.tmp", checkpointPath );
+    file = fopen( tmpPath, "wb" );
+    if( file == NULL )
+    {
+        return OPEN_FILE_FAIL;
+    }
+
+    written = written && fwrite( CHECKPOINT_MAGIC, 8, 1, file ) == 1;
+    written = written &&
+              fwrite( &CHECKPOINT_VERSION, sizeof( int ), 1, file ) == 1;
+    written = written &&
+              fwrite( sched->configData, sizeof( Config ), 1, file ) == 1;
+    written = written && fwrite( &virtualTime, sizeof( int ), 1, file ) == 1;
+    written = written && fwrite( &currTime, sizeof( double ), 1, file ) == 1;
+
+    count = mdListCount( procList->mdList );
+    written = written && fwrite( &count, sizeof( int ), 1, file ) == 1;
+    for( currOp = mdListFirst( procList->mdList ); currOp != NULL;
+         currOp = currOp->next )
+    {
+        written = written &&
+                  fwrite( &currOp->command, sizeof( char ), 1, file ) == 1;
+        written = written &&
+                  fwrite( &currOp->value, sizeof( int ), 1, file ) == 1;
+        written = written && writeString( file, currOp->operation );
+    }
+
+    count = procListCount( procList );
+    written = written && fwrite( &count, sizeof( int ), 1, file ) == 1;
+    for( currBlock = procListFirst( procList ); currBlock != NULL;
+         currBlock = currBlock->next )
+    {
+        record.pid = currBlock->pid;
+        record.state = currBlock->state;
+        record.processTime = currBlock->processTime;
+        record.headIndex = nodeIndex( procList->mdList,
+                                      currBlock->processHead );
+        record.opCyclesDone = currBlock->opCyclesDone;
+        record.cyclesRun = currBlock->cyclesRun;
+        record.segFaulted = currBlock->segFaulted;
+        record.priority = currBlock->priority;
+        record.tickets = currBlock->tickets;
+        record.stride = currBlock->stride;
+        record.pass = currBlock->pass;
+        record.arrivalTime = currBlock->arrivalTime;
+        record.firstRunTime = currBlock->firstRunTime;
+        record.completionTime = currBlock->completionTime;
+        record.readyWaitTime = currBlock->readyWaitTime;
+        record.blockedTime = currBlock->blockedTime;
+        record.runTime = currBlock->runTime;
+        record.stateTime = currBlock->stateTime;
+        record.ioDueTime = currBlock->ioDueTime;
+        written = written &&
+                  fwrite( &record, sizeof( CheckpointPCB ), 1, file ) == 1;
+    }
+
+    // Blocked PCBs oldest first, the order their interrupts were posted
+    order = malloc( sizeof( ProcessControlBlock * ) * ( count + 1 ) );
+    count = 0;
+    for( currBlock = procStateFirst( procList, BLOCKED ); currBlock != NULL;
+         currBlock = currBlock->nextInState )
+    {
+        order[ count++ ] = currBlock;
+    }
+    written = written && fwrite( &count, sizeof( int ), 1, file ) == 1;
+    for( index = count - 1; index >= 0; index-- )
+    {
+        written = written &&
+                  fwrite( &order[ index ]->pid, sizeof( int ), 1, file ) == 1;
+    }
+
+    count = schedulerReadyOrder( sched, order );
+    written = written && fwrite( &count, sizeof( int ), 1, file ) == 1;
+    for( index = 0; index < count; index++ )
+    {
+        written = written &&
+                  fwrite( &order[ index ]->pid, sizeof( int ), 1, file ) == 1;
+    }
+    free( order );
+
+    pthread_mutex_lock( &mmu->lock );
+    count = MMUListCount( mmu );
+    written = written &&
+              fwrite( &mmu->totalMemory, sizeof( int ), 1, file ) == 1;
+    written = written && fwrite( &count, sizeof( int ), 1, file ) == 1;
+    for( alloc = MMUListFirst( mmu ); alloc != NULL; alloc = alloc->next )
+    {
+        written = written && fwrite( &alloc->pid, sizeof( int ), 1, file ) == 1;
+        written = written && fwrite( &alloc->sid, sizeof( int ), 1, file ) == 1;
+        written = written &&
+                  fwrite( &alloc->base, sizeof( int ), 1, file ) == 1;
+        written = written &&
+                  fwrite( &alloc->offset, sizeof( int ), 1, file ) == 1;
+    }
+    pthread_mutex_unlock( &mmu->lock );
+
+    pthread_mutex_lock( &logList->lock );
+    count = logListCount( logList );
+    written = written && fwrite( &count, sizeof( int ), 1, file ) == 1;
+    for( currLog = logListFirst( logList ); currLog != NULL;
+         currLog = currLog->next )
+    {
+        written = written && writeString( file, currLog->logStr );
+    }
+    pthread_mutex_unlock( &logList->lock );
+
+    if( fclose( file ) != 0 || !written ||
+        rename( tmpPath, checkpointPath ) != 0 )
+    {
+        remove( tmpPath );
+        return OPEN_FILE_FAIL;
+    }
+    return NO_ERROR_MSG;
+}
+
+//==========================================================================
+/**
+* @brief Function restores a simulation from a checkpoint file
+*
+* @details Function fills the given, empty, structures so that running
+*   the scheduler on them carries the checkpointed run on. The clock is
+*   started at the checkpoint's time. Blocked PCBs keep the time their
+*   I/O ends, for the dispatcher to post again. Ready PCBs are made Ready
+*   in the scheduler's ready order, so a new scheduler rebuilds the same
+*   ready structure.
+*
+* @param[in] checkpointPath
+* Path of the checkpoint file
+*
+* @param[out] configData
+* Receives the checkpointed Config
+*
+* @param[out] mdList
+* An empty MetadataList receiving the metadata
+*
+* @param[out] procList
+* An empty ProcessList receiving the PCBs, its clock already set
+*
+* @param[out] mmu
+* An empty MMUList receiving the total memory and allocations
+*
+* @param[out] logList
+* An empty LogList receiving the log so far, its clock is started
+*
+* @return no error message if restored, file not found if the file could
+*   not be opened, invalid data if it is not a whole checkpoint of this
+*   build
+*/
+int readCheckpoint( char *checkpointPath, Config *configData,
+                    MetadataList *mdList, ProcessList *procList,
+                    MMUList *mmu, LogList *logList )
+{
+    FILE *file = fopen( checkpointPath, "rb" );
+    MetadataNode **nodes = NULL;
+    MetadataNode *currOp;
+    MMUNode *alloc;
+    char magic[ 9 ];
+    char str[ STD_STR ];
+    char command;
+    int version, virtualTime, count, index, value;
+    int pid, sid, base, offset;
+    int status = INVALID_DATA;
+    double currTime;
+
+    if( file == NULL )
+    {
+        return FILE_NOT_FOUND_ERR;
+    }
+
+    magic[ 8 ] = NUL;
+    if( fread( magic, 8, 1, file ) != 1 ||
+        stringCompare( magic, ( char * )CHECKPOINT_MAGIC ) != 0 ||
+        fread( &version, sizeof( int ), 1, file ) != 1 ||
+        version != CHECKPOINT_VERSION ||
+        fread( configData, sizeof( Config ), 1, file ) != 1 ||
+        fread( &virtualTime, sizeof( int ), 1, file ) != 1 ||
+        fread( &currTime, sizeof( double ), 1, file ) != 1 ||
+        fread( &count, sizeof( int ), 1, file ) != 1 || count < 1 )
+    {
+        fclose( file );
+        return INVALID_DATA;
+    }
+
+    for( index = 0; index < count; index++ )
+    {
+        if( fread( &command, sizeof( char ), 1, file ) != 1 ||
+            fread( &value, sizeof( int ), 1, file ) != 1 ||
+            !readString( file, str, STD_STR ) )
+        {
+            fclose( file );
+            return INVALID_DATA;
+        }
+        addMdNode( mdList, createMdNode( command, str, value ) );
+    }
+
+    if( fillProcessList( procList, mdList, configData ) != NO_ERROR_MSG )
+    {
+        fclose( file );
+        return INVALID_DATA;
+    }
+
+    // PCBs are stamped with the checkpoint's time as they are restored
+    logList->clock.virtualTime = virtualTime ? True : False;
+    resumeClock( &logList->clock, currTime );
+
+    nodes = malloc( sizeof( MetadataNode * ) * count );
+    for( index = 0, currOp = mdListFirst( mdList ); currOp != NULL;
+         index++, currOp = currOp->next )
+    {
+        nodes[ index ] = currOp;
+    }
+
+    if( readPCBs( file, procList, nodes, count ) == NO_ERROR_MSG &&
+        fread( &mmu->totalMemory, sizeof( int ), 1, file ) == 1 &&
+        fread( &count, sizeof( int ), 1, file ) == 1 )
+    {
+        mmu->availableMemory = mmu->totalMemory;
+        // allocations are placed afresh, in the order they were made, and
+        // page tables are not kept, pages fault in again as they are used
+        mmu->paging = createPaging( mmu->totalMemory, configData );
+        mmu->buddy = createBuddyAllocator( mmu->totalMemory, configData );
+        status = NO_ERROR_MSG;
+        for( index = 0; index < count && status == NO_ERROR_MSG; index++ )
+        {
+            alloc = NULL;
+            // the pid is checked first, no allocation is made for a bad one
+            if( fread( &pid, sizeof( int ), 1, file ) == 1 &&
+                fread( &sid, sizeof( int ), 1, file ) == 1 &&
+                fread( &base, sizeof( int ), 1, file ) == 1 &&
+                fread( &offset, sizeof( int ), 1, file ) == 1 &&
+                pid >= 0 && pid < procListCount( procList ) )
+            {
+                alloc = createMMUNode( pid, sid, base, offset, configData,
+                                       mmu );
+            }
+            if( alloc == NULL )
+            {
+                status = INVALID_DATA;
+            }
+            else
+            {
+                addMMUNode( mmu, alloc );
+                chainMMUNode( &procList->pidTable[ pid ]->firstAlloc, alloc );
+            }
+        }
+    }
+
+    if( status == NO_ERROR_MSG &&
+        fread( &count, sizeof( int ), 1, file ) == 1 )
+    {
+        for( index = 0; index < count && status == NO_ERROR_MSG; index++ )
+        {
+            if( readString( file, str, STD_LOG_STR ) )
+            {
+                addLogNode( logList, createLogNode( str ) );
+            }
+            else
+            {
+                status = INVALID_DATA;
+            }
+        }
+    }
+    else
+    {
+        status = INVALID_DATA;
+    }
+
+    free( nodes );
+    fclose( file );
+    return status;
+}
+
+//==========================================================================
+/**
+* @brief Function restores every PCB and the state each one was in
+*
+* @details Exited PCBs are restored in PID order, then the Blocked and
+*   Ready PCBs in the order they were written. Every time the metrics use
+*   is set once all states are, since each change of state stamps them.
+*
+* @param[in] file
+* The checkpoint file, at the PCB count
+*
+* @param[in] procList
+* A ProcessList holding every PCB, all still New
+*
+* @param[in] nodes
+* The metadata nodes, by index
+*
+* @param[in] numNodes
+* How many metadata nodes there are
+*
+* @return no error message if every PCB was restored, invalid data
+*   otherwise
+*/
+static int readPCBs( FILE *file, ProcessList *procList,
+                     MetadataNode **nodes, int numNodes )
+{
+    ProcessControlBlock *pcb;
+    CheckpointPCB *records;
+    int count, index;
+    int status = NO_ERROR_MSG;
+
+    if( fread( &count, sizeof( int ), 1, file ) != 1 ||
+        count != procListCount( procList ) )
+    {
+        return INVALID_DATA;
+    }
+
+    records = malloc( sizeof( CheckpointPCB ) * ( count + 1 ) );
+    if( fread( records, sizeof( CheckpointPCB ), count, file )
+        != ( size_t )count )
+    {
+        free( records );
+        return INVALID_DATA;
+    }
+
+    for( index = 0; index < count && status == NO_ERROR_MSG; index++ )
+    {
+        if( records[ index ].pid < 0 || records[ index ].pid >= count ||
+            records[ index ].headIndex < 0 ||
+            records[ index ].headIndex >= numNodes )
+        {
+            status = INVALID_DATA;
+            continue;
+        }
+
+        pcb = procList->pidTable[ records[ index ].pid ];
+        pcb->processTime = records[ index ].processTime;
+        pcb->processHead = nodes[ records[ index ].headIndex ];
+        pcb->opCyclesDone = records[ index ].opCyclesDone;
+        pcb->cyclesRun = records[ index ].cyclesRun;
+        pcb->segFaulted = records[ index ].segFaulted;
+        pcb->priority = records[ index ].priority;
+        pcb->tickets = records[ index ].tickets;
+        pcb->stride = records[ index ].stride;
+        pcb->pass = records[ index ].pass;
+        pcb->ioDueTime = records[ index ].ioDueTime;
+
+        if( records[ index ].state == EXIT )
+        {
+            setPCBState( procList, pcb, EXIT );
+        }
+    }
+
+    if( status == NO_ERROR_MSG )
+    {
+        status = readStateOrder( file, procList, BLOCKED );
+    }
+    if( status == NO_ERROR_MSG )
+    {
+        status = readStateOrder( file, procList, READY );
+    }
+
+    for( index = 0; index < count && status == NO_ERROR_MSG; index++ )
+    {
+        pcb = procList->pidTable[ records[ index ].pid ];
+        if( ( int )pcb->state != records[ index ].state )
+        {
+            status = INVALID_DATA;
+            continue;
+        }
+
+        pcb->arrivalTime = records[ index ].arrivalTime;
+        pcb->firstRunTime = records[ index ].firstRunTime;
+        pcb->completionTime = records[ index ].completionTime;
+        pcb->readyWaitTime = records[ index ].readyWaitTime;
+        pcb->blockedTime = records[ index ].blockedTime;
+        pcb->runTime = records[ index ].runTime;
+        pcb->stateTime = records[ index ].stateTime;
+    }
+
+    free( records );
+    return status;
+}
+
+//==========================================================================
+/**
+* @brief Function moves the listed PCBs into a state, in the listed order
+*
+* @param[in] file
+* The checkpoint file, at the count of PIDs
+*
+* @param[in] procList
+* A ProcessList holding the PCBs
+*
+* @param[in] state
+* The state to move them to
+*
+* @return no error message if every PID was valid, invalid data otherwise
+*/
+static int readStateOrder( FILE *file, ProcessList *procList,
+                           PROC_STATE state )
+{
+    int count, index, pid;
+
+    if( fread( &count, sizeof( int ), 1, file ) != 1 )
+    {
+        return INVALID_DATA;
+    }
+
+    for( index = 0; index < count; index++ )
+    {
+        if( fread( &pid, sizeof( int ), 1, file ) != 1 ||
+            pid < 0 || pid >= procListCount( procList ) )
+        {
+            return INVALID_DATA;
+        }
+        setPCBState( procList, procList->pidTable[ pid ], state );
+    }
+    return NO_ERROR_MSG;
+}
+
+//==========================================================================
+/**
+* @brief Function returns the position of a node in the metadata list
+*
+* @param[in] mdList
+* A MetadataList pointer
+*
+* @param[in] node
+* A node of that list
+*
+* @return the node's index from the first node
+*/
+static int nodeIndex( MetadataList *mdList, MetadataNode *node )
+{
+    MetadataNode *currOp = mdListFirst( mdList );
+    int index = 0;
+
+    while( currOp != NULL && currOp != node )
+    {
+        currOp = currOp->next;
+        index++;
+    }
+    return index;
+}
+
+//==========================================================================
+/**
+* @brief Function writes a string as its length then its characters
+*
+* @param[in] file
+* The file to write to
+*
+* @param[in] str
+* The string to write
+*
+* @return 1 if written, 0 otherwise
+*/
+static int writeString( FILE *file, char *str )
+{
+    int length = stringLength( str );
+
+    return fwrite( &length, sizeof( int ), 1, file ) == 1 &&
+           fwrite( str, sizeof( char ), length, file ) == ( size_t )length;
+}
+
+//==========================================================================
+/**
+* @brief Function reads a string written by writeString()
+*
+* @param[in] file
+* The file to read from
+*
+* @param[out] str
+* Receives the string
+*
+* @param[in] size
+* Size of str, a longer string is not read
+*
+* @return 1 if read, 0 otherwise
+*/
+static int readString( FILE *file, char *str, int size )
+{
+    int length;
+
+    if( fread( &length, sizeof( int ), 1, file ) != 1 ||
+        length < 0 || length >= size ||
+        fread( str, sizeof( char ), length, file ) != ( size_t )length )
+    {
+        return 0;
+    }
+    str[ length ] = NUL;
+    return 1;
+}
+
+//==========================================================================
+// Terminating Precompiler Directives ///////////////////////////////
+//
+///// NONE
+//
@@ -0,0 +1,93 @@
+// PROGRAMMER INFORMATION ////////////////////////////////////////////
+/**
+
+Secret Number: 764819
+
+*/
+// Header File Information /////////////////////////////////////
+/**
+* @file checkpoint.h
+*
+* @brief Header file for checkpoint code
+*
+* @details Specifies functions, constants, and other information
+* related to saving a running simulation to a file and restoring it
+*/
+// Precompiler Directives //////////////////////////////////////////
+//
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+//
+// Header Files ///////////////////////////////////////////////////
+//
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "configParser.h"
+#include "metadataList.h"
+#include "processList.h"
+#include "logList.h"
+#include "mmuList.h"
+#include "scheduler.h"
+#include "utilities.h"
+//
+// Global Constant Definitions ////////////////////////////////////
+//
+extern const char RESUME_FLAG[];
+extern const char CHECKPOINT_MAGIC[];
+extern const int CHECKPOINT_VERSION;
+//
+// Data Structure Definitions (structs, enums, etc.)////////////////
+//
+/*
+  Everything a checkpoint keeps of one PCB. headIndex is the position of
+  its processHead in the metadata list.
+*/
+typedef struct CheckpointPCB
+{
+    int pid;
+    int state;
+    int processTime;
+    int headIndex;
+    int opCyclesDone;
+    int cyclesRun;
+    int segFaulted;
+    int priority;
+    int tickets;
+    long stride;
+    long pass;
+    double arrivalTime;
+    double firstRunTime;
+    double completionTime;
+    double readyWaitTime;
+    double blockedTime;
+    double runTime;
+    double stateTime;
+    double ioDueTime;
+} CheckpointPCB;
+//
+// Free Function Prototypes ///////////////////////////////////////
+//
+//==========================================================================
+
+void installCheckpointSignal( void );
+
+//==========================================================================
+
+int checkpointDue( Config *configData, double currTime,
+                   double *nextCheckpoint );
+
+//==========================================================================
+
+int writeCheckpoint( char *checkpointPath, Scheduler *sched, MMUList *mmu );
+
+//==========================================================================
+
+int readCheckpoint( char *checkpointPath, Config *configData,
+                    MetadataList *mdList, ProcessList *procList,
+                    MMUList *mmu, LogList *logList );
+
+// Terminating Precompiler Directives ///////////////////////////////
+//
+#endif // CHECKPOINT_H
+//
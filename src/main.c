@@ -24,6 +24,15 @@ validated and stored in a struct, then opens a metadata file
 name that is stored in that struct, parses that file, validates,
 and stores that information into a linked list. Then both the
 struct and linked list are printed to the screen.
+
+Given --batch and a job file instead, with -j and a worker count, it
+runs every configuration the job file lists, that many at a time, and
+prints a summary of all of them. Given --sweep, a configuration file
+and field=values ranges, it runs every combination of the values.
+Given --resume and a checkpoint file, it carries on the run the
+checkpoint was written from. A single run writes a checkpoint when sent
+SIGUSR1. Given --mmu-bench and a segment count, it times MMU lookups
+with that many live segments.
 */
 // Header Files ///////////////////////////////////////////////////
 //
@@ -33,6 +42,9 @@ struct and linked list are printed to the screen.
 #include "processList.h"
 #include "utilities.h"
 #include "simulator.h"
+#include "batch.h"
+#include "sweep.h"
+#include "mmuBench.h"
 //
 // Free Function Prototypes ///////////////////////////////////////
 //
@@ -43,6 +55,61 @@ void printMetadata( MetadataList *list );
 //
 int main ( int argc, char *argv[] )
 {
+    if( argc >= 3 && stringCompare( argv[1], BATCH_FLAG ) == 0 )
+    {
+        int numWorkers = 1;
+
+        if( argc == 5 && stringCompare( argv[3], WORKERS_FLAG ) == 0 )
+        {
+            numWorkers = stringToInt( argv[4] );
+        }
+        else if( argc != 3 )
+        {
+            numWorkers = 0;
+        }
+
+        if( numWorkers < 1 || numWorkers > MAX_BATCH_WORKERS )
+        {
+            printf( "===ERR: USAGE %s %s JOB_FILE [%s 1-%d]===\n",
+                    argv[0], BATCH_FLAG, WORKERS_FLAG, MAX_BATCH_WORKERS );
+            return 0;
+        }
+
+        if( runBatch( argv[2], numWorkers ) != NO_ERROR_MSG )
+        {
+            printf( "===ERR: INVALID OR MISSING JOB FILE===\n" );
+        }
+        return 0;
+    }
+
+    if( argc >= 3 && stringCompare( argv[1], SWEEP_FLAG ) == 0 )
+    {
+        // errors are reported by the sweep itself
+        runSweep( argc - 2, &argv[2] );
+        return 0;
+    }
+
+    if( argc == 3 && stringCompare( argv[1], MMU_BENCH_FLAG ) == 0 )
+    {
+        if( runMMUBench( stringToInt( argv[2] ) ) != NO_ERROR_MSG )
+        {
+            printf( "===ERR: USAGE %s %s SEGMENTS 1-%d===\n",
+                    argv[0], MMU_BENCH_FLAG, MAX_BENCH_SEGMENTS );
+        }
+        return 0;
+    }
+
+    if( argc == 3 && stringCompare( argv[1], RESUME_FLAG ) == 0 )
+    {
+        installCheckpointSignal();
+        setvbuf( stdout, NULL, _IONBF, 0 );
+        if( resumeSimulator( argv[2], NULL ) != NO_ERROR_MSG )
+        {
+            printf( "===ERR: INVALID OR MISSING CHECKPOINT FILE===\n" );
+        }
+        return 0;
+    }
+
     if ( argc != 2 )
     {
         printf( "===ERR: %s REQUIRES CONFIGURATION FILE ARGUMENT===\n",
@@ -93,7 +160,8 @@ int main ( int argc, char *argv[] )
 
 		// using this for fixung a bug that resulted from concurrent processes
 		setvbuf(stdout, NULL, _IONBF, 0); // turn off buffering for stdout
-        runSimulator( mdList, configData );
+        installCheckpointSignal();
+        runSimulator( mdList, configData, NULL );
 
         mdListDestroy( mdList );
         free( configData );
@@ -129,6 +197,25 @@ void printConfig( Config *config )
     printf( "I/O Cycle Time     : %d\n", config->ioCycleTime );
     printf( "Log to code        : %s\n", config->logTo );
     printf( "Log file name      : %s\n", config->logFilePath );
+    printf( "CPU count          : %d\n", config->cpuCount );
+    printf( "MLFQ levels        : %d\n", config->mlfqLevels );
+    printf( "MLFQ boost (msec)  : %d\n", config->mlfqBoostTime );
+    printf( "Metrics file name  : %s\n", config->metricsFilePath );
+    printf( "Virtual time       : %s\n", config->virtualTime ? "On" : "Off" );
+    printf( "Record interrupts  : %s\n", config->recordFilePath );
+    printf( "Replay interrupts  : %s\n", config->replayFilePath );
+    printf( "Checkpoint (msec)  : %d\n", config->checkpointInterval );
+    printf( "Checkpoint file    : %s\n", config->checkpointFilePath );
+    printf( "Interrupt batch    : %d\n", config->intBatchSize );
+    printf( "Batch delay        : %d\n", config->intBatchDelay );
+    printf( "Page size (KB)     : %d\n", config->pageSize );
+    printf( "TLB entries / ways : %d / %d\n", config->tlbEntries,
+                                             config->tlbWays );
+    printf( "Page fault cycles  : %d\n", config->pageFaultCycles );
+    printf( "Memory allocator   : %s\n",
+            config->buddyAllocator ? "Buddy" : "Fixed" );
+    printf( "Swap file name     : %s\n", config->swapFilePath );
+    printf( "Swap cycles        : %d\n", config->swapCycles );
     printf( "====================\n\n" );
 }
 
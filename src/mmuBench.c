@@ -0,0 +1,149 @@
+// PROGRAMMER INFORMATION ////////////////////////////////////////////
+/**
+
+Secret Number: 764819
+
+*/
+// Code Implementation File Information /////////////////////////////
+/**
+* @file mmuBench.c
+*
+* @brief Implementation file for mmuBench code
+*
+* @details Implements the MMU lookup benchmark
+*/
+// Program Description/Support /////////////////////////////////////
+/*
+This program fills an MMU with the given number of live segments, each
+owned by one of a few processes, then times looking segments up the way
+an M(access) op does: through the sid table, and by walking the list as
+accessMem() used to. The list walk is timed over fewer lookups, since
+each one is so much slower.
+*/
+// Header Files ///////////////////////////////////////////////////
+//
+#include "mmuBench.h"
+//
+// Global Constant Definitions ////////////////////////////////////
+//
+const char MMU_BENCH_FLAG[] = "--mmu-bench";
+const int MAX_BENCH_SEGMENTS = 1000000;
+const int BENCH_SEGMENT_SIZE = 10;
+const int BENCH_PROCESSES = 64;
+const int BENCH_SCAN_LOOKUPS = 1000;
+//
+// Free Function Prototypes ///////////////////////////////////////
+//
+static int benchSid( int lookup, int segments );
+//
+//==========================================================================
+/**
+* @brief Function times MMU lookups with the given number of segments
+*
+* @details The segments are laid end to end so every allocation is
+*   accepted. Each lookup asks for a segment of the process that owns
+*   it, as an access that succeeds would.
+*
+* @param[in] segments
+* The number of live segments, 1 to MAX_BENCH_SEGMENTS
+*
+* @return no error message, or invalid data if segments is out of range
+*   or an allocation or lookup fails
+*/
+int runMMUBench( int segments )
+{
+    MMUList *mmu;
+    MMUNode *node;
+    SimClock clock;
+    char timeStr[ 20 ];
+    double hashTime, scanTime;
+    int lookups = 10 * segments;
+    int scans = segments < BENCH_SCAN_LOOKUPS ? segments : BENCH_SCAN_LOOKUPS;
+    int index, sid, found = 0;
+
+    if( segments < 1 || segments > MAX_BENCH_SEGMENTS )
+    {
+        return INVALID_DATA;
+    }
+
+    mmu = MMUListCreate( segments * BENCH_SEGMENT_SIZE );
+    for( index = 0; index < segments; index++ )
+    {
+        node = createMMUNode( index % BENCH_PROCESSES, index,
+                              index * BENCH_SEGMENT_SIZE,
+                              BENCH_SEGMENT_SIZE, NULL, mmu );
+        if( node == NULL )
+        {
+            MMUListDestroy( mmu );
+            return INVALID_DATA;
+        }
+        addMMUNode( mmu, node );
+    }
+
+    initClock( &clock );
+    accessTimer( &clock, ZERO_TIMER, timeStr );
+    for( index = 0; index < lookups; index++ )
+    {
+        sid = benchSid( index, segments );
+        found += MMUFind( mmu, sid % BENCH_PROCESSES, sid ) != NULL;
+    }
+    hashTime = accessTimer( &clock, LAP_TIMER, timeStr );
+
+    for( index = 0; index < scans; index++ )
+    {
+        sid = benchSid( index, segments );
+        node = MMUListFirst( mmu );
+        while( node != NULL && ( node->sid != sid ||
+                                 node->pid != sid % BENCH_PROCESSES ) )
+        {
+            node = node->next;
+        }
+        found += node != NULL;
+    }
+    scanTime = accessTimer( &clock, LAP_TIMER, timeStr ) - hashTime;
+
+    MMUListDestroy( mmu );
+    if( found != lookups + scans )
+    {
+        return INVALID_DATA;
+    }
+
+    printf( "MMU benchmark, %d live segments\n", segments );
+    printf( "====================\n" );
+    printf( "Sid table lookup   : %.1f nsec ( %d lookups )\n",
+            hashTime * 1e9 / lookups, lookups );
+    printf( "List scan lookup   : %.1f nsec ( %d lookups )\n",
+            scanTime * 1e9 / scans, scans );
+    printf( "Speedup            : %.0fx\n",
+            hashTime > 0.0 ? ( scanTime / scans ) / ( hashTime / lookups )
+                           : 0.0 );
+    printf( "====================\n" );
+
+    return NO_ERROR_MSG;
+}
+
+//==========================================================================
+/**
+* @brief Function picks the sid looked up by one lookup
+*
+* @details The sids are spread over all the segments rather than taken
+*   in order, so the lookups do not walk memory in allocation order.
+*
+* @param[in] lookup
+* The number of the lookup
+*
+* @param[in] segments
+* The number of live segments
+*
+* @return the sid
+*/
+static int benchSid( int lookup, int segments )
+{
+    return ( int )( ( lookup * 7919L ) % segments );
+}
+
+//==========================================================================
+// Terminating Precompiler Directives ///////////////////////////////
+//
+///// NONE
+//
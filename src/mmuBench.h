@@ -0,0 +1,43 @@
+// PROGRAMMER INFORMATION ////////////////////////////////////////////
+/**
+
+Secret Number: 764819
+
+*/
+// Header File Information /////////////////////////////////////
+/**
+* @file mmuBench.h
+*
+* @brief Header file for mmuBench code
+*
+* @details Specifies functions, constants, and other information
+* related to timing MMU lookups with many live segments
+*/
+// Precompiler Directives //////////////////////////////////////////
+//
+#ifndef MMU_BENCH_H
+#define MMU_BENCH_H
+//
+// Header Files ///////////////////////////////////////////////////
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include "mmuList.h"
+#include "simtimer.h"
+#include "utilities.h"
+//
+// Global Constant Definitions ////////////////////////////////////
+//
+extern const char MMU_BENCH_FLAG[];
+extern const int MAX_BENCH_SEGMENTS;
+//
+// Free Function Prototypes ///////////////////////////////////////
+//
+//==========================================================================
+
+int runMMUBench( int segments );
+
+// Terminating Precompiler Directives ///////////////////////////////
+//
+#endif // MMU_BENCH_H
+//
@@ -0,0 +1,685 @@
+// PROGRAMMER INFORMATION ////////////////////////////////////////////
+/**
+
+Secret Number: 764819
+
+*/
+// Code Implementation File Information /////////////////////////////
+/**
+* @file scheduler.c
+*
+* @brief Implementation file for scheduler code
+*
+* @details Implements every scheduling policy as a set of hooks
+*/
+// Program Description/Support /////////////////////////////////////
+/*
+This program builds a Scheduler for the configured schedule code. Each
+policy only says how Ready processes are held and picked, and what
+happens when a process blocks, runs a cycle or exits; the dispatch loop
+in the simulator is shared by all of them. The schedule code is looked
+up once, when the scheduler is created.
+*/
+// Header Files ///////////////////////////////////////////////////
+//
+#include "scheduler.h"
+#include "simulator.h"
+//
+// Data Structure Definitions (structs, enums, etc.)////////////////
+//
+typedef struct SchedulerEntry
+{
+    const char *code;
+    void ( *install )( Scheduler *sched );
+} SchedulerEntry;
+//
+// Free Function Prototypes ///////////////////////////////////////
+//
+static void installFCFSN( Scheduler *sched );
+static void installSJFN( Scheduler *sched );
+static void installSRTFP( Scheduler *sched );
+static void installFCFSP( Scheduler *sched );
+static void installRRP( Scheduler *sched );
+static void installMLFQP( Scheduler *sched );
+static void installStrideP( Scheduler *sched );
+//
+// Global Constant Definitions ////////////////////////////////////
+//
+static const SchedulerEntry SCHEDULERS[] =
+{
+    { FCFS_N, installFCFSN },
+    { SJF_N, installSJFN },
+    { SRTF_P, installSRTFP },
+    { FCFS_P, installFCFSP },
+    { RR_P, installRRP },
+    { MLFQ_P, installMLFQP },
+    { STRIDE_P, installStrideP }
+};
+static const int NUM_SCHEDULERS =
+    sizeof( SCHEDULERS ) / sizeof( SCHEDULERS[ 0 ] );
+//
+//==========================================================================
+/**
+* @brief Function passes a process list state change to the policy's hook
+*
+* @param[in] owner
+* The Scheduler registered with the process list
+*
+* @param[in] pcb
+* The PCB that changed state
+*
+* @param[in] state
+* The state the PCB moved to
+*/
+static void schedulerStateChange( void *owner, ProcessControlBlock *pcb,
+                                  PROC_STATE state )
+{
+    Scheduler *sched = ( Scheduler * )( owner );
+
+    if( state == READY && sched->onReady != NULL )
+    {
+        sched->onReady( sched, pcb );
+    }
+    else if( state == BLOCKED && sched->onBlock != NULL )
+    {
+        sched->onBlock( sched, pcb );
+    }
+    else if( state == EXIT && sched->onExit != NULL )
+    {
+        sched->onExit( sched, pcb );
+    }
+}
+
+//==========================================================================
+/**
+* @brief Function picks the PCB at the head of the FIFO ready queue
+*
+* @param[in] sched
+* A Scheduler pointer
+*
+* @return the next PCB, or NULL if none are Ready
+*/
+static ProcessControlBlock *queuePick( Scheduler *sched )
+{
+    return dequeuePCB( sched->queue );
+}
+
+//==========================================================================
+/**
+* @brief Function adds a PCB to the tail of the FIFO ready queue
+*
+* @param[in] sched
+* A Scheduler pointer
+*
+* @param[in] pcb
+* The PCB now Ready
+*/
+static void queueReady( Scheduler *sched, ProcessControlBlock *pcb )
+{
+    enqueuePCB( sched->queue, pcb );
+}
+
+//==========================================================================
+/**
+* @brief Function picks the smallest PCB in the ready heap
+*
+* @param[in] sched
+* A Scheduler pointer
+*
+* @return the next PCB, or NULL if none are Ready
+*/
+static ProcessControlBlock *heapPick( Scheduler *sched )
+{
+    return heapRemoveMin( sched->heap );
+}
+
+//==========================================================================
+/**
+* @brief Function adds a PCB to the ready heap
+*
+* @param[in] sched
+* A Scheduler pointer
+*
+* @param[in] pcb
+* The PCB now Ready
+*/
+static void heapReady( Scheduler *sched, ProcessControlBlock *pcb )
+{
+    heapInsertPCB( sched->heap, pcb );
+}
+
+//==========================================================================
+/**
+* @brief Function picks the Ready PCB with the lowest PID
+*
+* @details The process list keeps its Ready PID bitmap itself, so this
+*   policy needs no ready structure of its own.
+*
+* @param[in] sched
+* A Scheduler pointer
+*
+* @return the next PCB, or NULL if none are Ready
+*/
+static ProcessControlBlock *lowestPidPick( Scheduler *sched )
+{
+    return procLowestReady( sched->procList );
+}
+
+//==========================================================================
+/**
+* @brief Function ends a time slice after the configured quantum
+*
+* @details The process logs a quantum time out and carries on running,
+*   which is how the original preemptive schedulers behave.
+*
+* @param[in] sched
+* A Scheduler pointer
+*
+* @param[in] pcb
+* The running PCB
+*
+* @param[in] sliceCycles
+* Cycles run so far in this time slice
+*
+* @param[in] remainingCycles
+* Cycles left in the current run operation
+*
+* @return SLICE_EXPIRED at the end of a quantum, SLICE_CONTINUE otherwise
+*/
+static SLICE_ACTION quantumTick( Scheduler *sched, ProcessControlBlock *pcb,
+                                 int sliceCycles, int remainingCycles )
+{
+    if( sliceCycles == sched->configData->quantumTime && remainingCycles > 0 )
+    {
+        return SLICE_EXPIRED;
+    }
+    return SLICE_CONTINUE;
+}
+
+//==========================================================================
+/**
+* @brief Function picks from the highest non-empty feedback level
+*
+* @details Once the boost interval has passed since the last boost, every
+*   process is returned to the top level first.
+*
+* @param[in] sched
+* A Scheduler pointer
+*
+* @return the next PCB, or NULL if none are Ready
+*/
+static ProcessControlBlock *feedbackPick( Scheduler *sched )
+{
+    char timeStr[ 20 ];
+    double currTime = accessTimer( &sched->logList->clock, LAP_TIMER,
+                                   timeStr );
+
+    if( sched->configData->mlfqBoostTime > 0 &&
+        ( currTime - sched->lastBoost ) * 1000.0 >=
+        sched->configData->mlfqBoostTime )
+    {
+        feedbackBoost( sched->feedback, sched->procList );
+        logAction( "OS: MLFQ-P priority boost, all processes at level 0",
+                   sched->configData, sched->logList );
+        sched->lastBoost = currTime;
+    }
+    return feedbackDequeue( sched->feedback );
+}
+
+//==========================================================================
+/**
+* @brief Function queues a Ready PCB at its feedback level
+*
+* @param[in] sched
+* A Scheduler pointer
+*
+* @param[in] pcb
+* The PCB now Ready
+*/
+static void feedbackReady( Scheduler *sched, ProcessControlBlock *pcb )
+{
+    feedbackEnqueue( sched->feedback, pcb );
+}
+
+//==========================================================================
+/**
+* @brief Function raises a PCB a level when it blocks for I/O
+*
+* @param[in] sched
+* A Scheduler pointer
+*
+* @param[in] pcb
+* The PCB now Blocked
+*/
+static void feedbackBlock( Scheduler *sched, ProcessControlBlock *pcb )
+{
+    feedbackPromote( sched->feedback, pcb );
+}
+
+//==========================================================================
+/**
+* @brief Function drops a PCB a level when it uses its whole quantum
+*
+* @param[in] sched
+* A Scheduler pointer
+*
+* @param[in] pcb
+* The running PCB
+*
+* @param[in] sliceCycles
+* Cycles run so far in this time slice
+*
+* @param[in] remainingCycles
+* Cycles left in the current run operation
+*
+* @return SLICE_YIELD at the end of the level's quantum, SLICE_CONTINUE
+*   otherwise
+*/
+static SLICE_ACTION feedbackTick( Scheduler *sched, ProcessControlBlock *pcb,
+                                  int sliceCycles, int remainingCycles )
+{
+    if( sliceCycles >= feedbackQuantum( sched->feedback, pcb ) &&
+        remainingCycles > 0 )
+    {
+        feedbackDemote( sched->feedback, pcb );
+        return SLICE_YIELD;
+    }
+    return SLICE_CONTINUE;
+}
+
+//==========================================================================
+/**
+* @brief Function charges a PCB its stride for a cycle it ran
+*
+* @details The pass advances per cycle, so a process preempted part way
+*   through its quantum is only charged for what it used.
+*
+* @param[in] sched
+* A Scheduler pointer
+*
+* @param[in] pcb
+* The running PCB
+*
+* @param[in] sliceCycles
+* Cycles run so far in this time slice
+*
+* @param[in] remainingCycles
+* Cycles left in the current run operation
+*
+* @return SLICE_YIELD at the end of the quantum, SLICE_CONTINUE otherwise
+*/
+static SLICE_ACTION strideTick( Scheduler *sched, ProcessControlBlock *pcb,
+                                int sliceCycles, int remainingCycles )
+{
+    pcb->pass += pcb->stride;
+
+    if( sliceCycles >= sched->configData->quantumTime && remainingCycles > 0 )
+    {
+        return SLICE_YIELD;
+    }
+    return SLICE_CONTINUE;
+}
+
+//==========================================================================
+/**
+* @brief Function records the cycles every process has run when the first
+*   one exits
+*
+* @details Until then every process was competing for the CPU, so shares
+*   of that window are what the tickets should have produced.
+*
+* @param[in] sched
+* A Scheduler pointer
+*
+* @param[in] pcb
+* The PCB now in Exit
+*/
+static void strideExit( Scheduler *sched, ProcessControlBlock *pcb )
+{
+    ProcessList *procList = sched->procList;
+    ProcessControlBlock *currBlock = procListFirst( procList );
+
+    if( sched->contendedCycles != NULL )
+    {
+        return;
+    }
+
+    sched->contendedCycles =
+        malloc( sizeof( int ) * ( procListCount( procList ) + 1 ) );
+    while( currBlock != NULL )
+    {
+        sched->contendedCycles[ currBlock->pid ] = currBlock->cyclesRun;
+        currBlock = currBlock->next;
+    }
+}
+
+//==========================================================================
+/**
+* @brief Function logs each process's achieved CPU share against its
+*   ticket share
+*
+* @param[in] sched
+* A Scheduler pointer
+*/
+static void strideReport( Scheduler *sched )
+{
+    ProcessControlBlock *currBlock = procListFirst( sched->procList );
+    int *cycles = sched->contendedCycles;
+    char logStr[ STD_LOG_STR ];
+    long totalTickets = 0;
+    long totalCycles = 0;
+
+    if( cycles == NULL )
+    {
+        return;
+    }
+
+    while( currBlock != NULL )
+    {
+        totalTickets += currBlock->tickets;
+        totalCycles += cycles[ currBlock->pid ];
+        currBlock = currBlock->next;
+    }
+
+    currBlock = procListFirst( sched->procList );
+    while( currBlock != NULL )
+    {
+        snprintf( logStr, STD_LOG_STR,
+                  "OS: Process %d, %d tickets, target share %.1f%%, "
+                  "achieved %.1f%%", currBlock->pid, currBlock->tickets,
+                  100.0 * currBlock->tickets / totalTickets,
+                  totalCycles > 0 ?
+                  100.0 * cycles[ currBlock->pid ] / totalCycles : 0.0 );
+        logAction( logStr, sched->configData, sched->logList );
+        currBlock = currBlock->next;
+    }
+}
+
+//==========================================================================
+/**
+* @brief Function sets up first come first served, non-preemptive
+*
+* @param[in] sched
+* A Scheduler pointer
+*/
+static void installFCFSN( Scheduler *sched )
+{
+    sched->queue = createReadyQueue();
+    sched->pickNext = queuePick;
+    sched->onReady = queueReady;
+}
+
+//==========================================================================
+/**
+* @brief Function sets up shortest job first, non-preemptive
+*
+* @param[in] sched
+* A Scheduler pointer
+*/
+static void installSJFN( Scheduler *sched )
+{
+    sched->heap = createPCBHeap( procListCount( sched->procList ),
+                                 compareProcessTime );
+    sched->pickNext = heapPick;
+    sched->onReady = heapReady;
+}
+
+//==========================================================================
+/**
+* @brief Function sets up shortest remaining time first, preemptive
+*
+* @param[in] sched
+* A Scheduler pointer
+*/
+static void installSRTFP( Scheduler *sched )
+{
+    installSJFN( sched );
+    sched->preemptive = 1;
+    sched->onTick = quantumTick;
+}
+
+//==========================================================================
+/**
+* @brief Function sets up first come first served, preemptive
+*
+* @param[in] sched
+* A Scheduler pointer
+*/
+static void installFCFSP( Scheduler *sched )
+{
+    sched->preemptive = 1;
+    sched->pickNext = lowestPidPick;
+    sched->onTick = quantumTick;
+}
+
+//==========================================================================
+/**
+* @brief Function sets up round robin, preemptive
+*
+* @param[in] sched
+* A Scheduler pointer
+*/
+static void installRRP( Scheduler *sched )
+{
+    installFCFSN( sched );
+    sched->preemptive = 1;
+    sched->onTick = quantumTick;
+}
+
+//==========================================================================
+/**
+* @brief Function sets up the multi-level feedback queue, preemptive
+*
+* @param[in] sched
+* A Scheduler pointer
+*/
+static void installMLFQP( Scheduler *sched )
+{
+    char timeStr[ 20 ];
+
+    sched->feedback = createFeedbackQueue( sched->configData->mlfqLevels,
+                                           sched->configData->quantumTime );
+    sched->lastBoost = accessTimer( &sched->logList->clock, LAP_TIMER,
+                                    timeStr );
+    sched->preemptive = 1;
+    sched->pickNext = feedbackPick;
+    sched->onReady = feedbackReady;
+    sched->onBlock = feedbackBlock;
+    sched->onTick = feedbackTick;
+}
+
+//==========================================================================
+/**
+* @brief Function sets up stride proportional-share scheduling, preemptive
+*
+* @param[in] sched
+* A Scheduler pointer
+*/
+static void installStrideP( Scheduler *sched )
+{
+    sched->heap = createPCBHeap( procListCount( sched->procList ),
+                                 comparePass );
+    sched->preemptive = 1;
+    sched->pickNext = heapPick;
+    sched->onReady = heapReady;
+    sched->onTick = strideTick;
+    sched->onExit = strideExit;
+    sched->report = strideReport;
+}
+
+//==========================================================================
+/**
+* @brief Function creates the scheduler for the configured schedule code
+*
+* @details Function looks the schedule code up once, installs that
+*   policy's hooks, registers the scheduler for the process list's state
+*   changes, and hands it every PCB already Ready, in the order they
+*   became Ready.
+*
+* @param[in] configData
+* A pointer to a Config struct storing the given configuration data
+*
+* @param[in] procList
+* A pointer to a processList struct storing the created PCBs
+*
+* @param[in] logList
+* A pointer to a logList struct storing the created logs
+*
+* @return a pointer to the new scheduler, or NULL for an unknown code
+*/
+Scheduler *createScheduler( Config *configData, ProcessList *procList,
+                            LogList *logList )
+{
+    Scheduler *sched;
+    ProcessControlBlock *currBlock;
+    int index = 0;
+
+    while( index < NUM_SCHEDULERS &&
+           stringCompare( configData->scheduleCode,
+                          SCHEDULERS[ index ].code ) != 0 )
+    {
+        index++;
+    }
+    if( index == NUM_SCHEDULERS )
+    {
+        return NULL;
+    }
+
+    sched = malloc( sizeof( Scheduler ) );
+    sched->name = SCHEDULERS[ index ].code;
+    sched->preemptive = 0;
+    sched->configData = configData;
+    sched->procList = procList;
+    sched->logList = logList;
+    sched->queue = NULL;
+    sched->heap = NULL;
+    sched->feedback = NULL;
+    sched->lastBoost = 0.0;
+    sched->contendedCycles = NULL;
+    sched->pickNext = NULL;
+    sched->onReady = NULL;
+    sched->onBlock = NULL;
+    sched->onTick = NULL;
+    sched->onExit = NULL;
+    sched->report = NULL;
+
+    SCHEDULERS[ index ].install( sched );
+
+    procList->onStateChange = schedulerStateChange;
+    procList->stateOwner = sched;
+
+    // the Ready set is newest first, so hand it over from its far end
+    currBlock = procStateFirst( procList, READY );
+    while( currBlock != NULL && currBlock->nextInState != NULL )
+    {
+        currBlock = currBlock->nextInState;
+    }
+    while( currBlock != NULL && sched->onReady != NULL )
+    {
+        sched->onReady( sched, currBlock );
+        currBlock = currBlock->prevInState;
+    }
+
+    return sched;
+}
+
+//==========================================================================
+/**
+* @brief Function frees the scheduler and its ready structures
+*
+* @param[in] sched
+* A Scheduler pointer
+*
+* @return a freed and nulled Scheduler pointer
+*/
+Scheduler *destroyScheduler( Scheduler *sched )
+{
+    sched->procList->onStateChange = NULL;
+    sched->procList->stateOwner = NULL;
+
+    if( sched->queue != NULL )
+    {
+        sched->queue = destroyReadyQueue( sched->queue );
+    }
+    if( sched->heap != NULL )
+    {
+        sched->heap = destroyPCBHeap( sched->heap );
+    }
+    if( sched->feedback != NULL )
+    {
+        sched->feedback = destroyFeedbackQueue( sched->feedback );
+    }
+    free( sched->contendedCycles );
+    free( sched );
+
+    sched = NULL;
+    return sched;
+}
+
+//==========================================================================
+/**
+* @brief Function lists the Ready PCBs in the order that rebuilds the
+*   policy's ready structure
+*
+* @details Making the PCBs Ready again in this order, with their
+*   priorities and passes as they are, leaves a new scheduler of the same
+*   policy holding them exactly as this one does: FIFO queues front to
+*   back, feedback levels top down, and the heap in array order, which
+*   inserting again never reorders.
+*
+* @param[in] sched
+* A Scheduler pointer
+*
+* @param[out] order
+* Receives the Ready PCBs, room for every PCB in the process list
+*
+* @return the number of Ready PCBs
+*/
+int schedulerReadyOrder( Scheduler *sched, ProcessControlBlock **order )
+{
+    ProcessControlBlock *currBlock;
+    int count = 0, level;
+
+    if( sched->queue != NULL )
+    {
+        for( currBlock = sched->queue->first; currBlock != NULL;
+             currBlock = currBlock->nextInQueue )
+        {
+            order[ count++ ] = currBlock;
+        }
+    }
+    else if( sched->heap != NULL )
+    {
+        for( count = 0; count < sched->heap->count; count++ )
+        {
+            order[ count ] = sched->heap->blocks[ count ];
+        }
+    }
+    else if( sched->feedback != NULL )
+    {
+        for( level = 0; level < sched->feedback->numLevels; level++ )
+        {
+            for( currBlock = sched->feedback->levels[ level ]->first;
+                 currBlock != NULL; currBlock = currBlock->nextInQueue )
+            {
+                order[ count++ ] = currBlock;
+            }
+        }
+    }
+    else
+    {
+        // picked by PID, any order will do
+        for( currBlock = procStateFirst( sched->procList, READY );
+             currBlock != NULL; currBlock = currBlock->nextInState )
+        {
+            order[ count++ ] = currBlock;
+        }
+    }
+    return count;
+}
+
+//==========================================================================
+// Terminating Precompiler Directives ///////////////////////////////
+//
+///// NONE
+//
@@ -0,0 +1,97 @@
+// PROGRAMMER INFORMATION ////////////////////////////////////////////
+/**
+
+Secret Number: 764819
+
+*/
+// Header File Information /////////////////////////////////////
+/**
+* @file scheduler.h
+*
+* @brief Header file for scheduler code
+*
+* @details Specifies functions, constants, and other information
+* related to the scheduling policies the dispatcher runs
+*/
+// Precompiler Directives //////////////////////////////////////////
+//
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+//
+// Header Files ///////////////////////////////////////////////////
+//
+#include <stdlib.h>
+#include "configParser.h"
+#include "processList.h"
+#include "logList.h"
+#include "readyQueue.h"
+#include "pcbHeap.h"
+#include "feedbackQueue.h"
+//
+// Global Constant Definitions ////////////////////////////////////
+//
+///// NONE
+//
+// Data Structure Definitions (structs, enums, etc.)////////////////
+//
+/*
+  What a running process does after a cycle: keep running, log a quantum
+  time out and carry on, or log it and give up the CPU
+*/
+typedef enum SLICE_ACTION
+{
+    SLICE_CONTINUE, SLICE_EXPIRED, SLICE_YIELD
+} SLICE_ACTION;
+
+/*
+  One scheduling policy. The hooks are chosen once when the scheduler is
+  created, the dispatcher only calls through them. pickNext takes the
+  next PCB out of the policy's ready structure, a PCB only leaves Ready
+  by being picked. onReady, onBlock and onExit run on every change into
+  those states, onTick after every cycle a preemptive process runs. Any
+  hook but pickNext may be NULL.
+*/
+typedef struct Scheduler
+{
+    const char *name;
+    int preemptive;
+    Config *configData;
+    ProcessList *procList;
+    LogList *logList;
+
+    // ready structures, only the ones the policy uses are created
+    ReadyQueue *queue;
+    PCBHeap *heap;
+    FeedbackQueue *feedback;
+    double lastBoost;
+    int *contendedCycles;
+
+    ProcessControlBlock *( *pickNext )( struct Scheduler *sched );
+    void ( *onReady )( struct Scheduler *sched, ProcessControlBlock *pcb );
+    void ( *onBlock )( struct Scheduler *sched, ProcessControlBlock *pcb );
+    SLICE_ACTION ( *onTick )( struct Scheduler *sched,
+                              ProcessControlBlock *pcb, int sliceCycles,
+                              int remainingCycles );
+    void ( *onExit )( struct Scheduler *sched, ProcessControlBlock *pcb );
+    void ( *report )( struct Scheduler *sched );
+} Scheduler;
+//
+// Free Function Prototypes ///////////////////////////////////////
+//
+//==========================================================================
+
+Scheduler *createScheduler( Config *configData, ProcessList *procList,
+                            LogList *logList );
+
+//==========================================================================
+
+Scheduler *destroyScheduler( Scheduler *sched );
+
+//==========================================================================
+
+int schedulerReadyOrder( Scheduler *sched, ProcessControlBlock **order );
+
+// Terminating Precompiler Directives ///////////////////////////////
+//
+#endif // SCHEDULER_H
+//
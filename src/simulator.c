@@ -22,9 +22,12 @@ using a timer and threads to run each operation code.
 //
 #include "simulator.h"
 //
-//// Global Variables
+// Global Constant Definitions ////////////////////////////////////
 //
-pthread_mutex_t mutex;
+// containers and their interrupts are built by the CPUs, an I/O thread
+// only fills in and posts the interrupt and gives the container back
+static ObjectPool containerPool = { sizeof( ThreadContainer ),
+                                    PTHREAD_MUTEX_INITIALIZER };
 //
 // Free Function Prototypes ///////////////////////////////////////
 //
@@ -44,17 +47,33 @@ pthread_mutex_t mutex;
 *
 * @param[in] configData
 *   A pointer to a Config struct storing the given configuration data
+*
+* @param[out] result
+*   A pointer to a SimResult struct receiving the summary of the run, or
+*   NULL if the caller does not want it
 */
-void runSimulator( MetadataList *mdList, Config *configData )
+void runSimulator( MetadataList *mdList, Config *configData,
+                   SimResult *result )
 {
     ProcessList *procList = procListCreate();
     LogList *logList = logListCreate();
     MMUList *mmu = MMUListCreate( configData->memorySize );
 
+    mmu->paging = createPaging( mmu->totalMemory, configData );
+    mmu->buddy = createBuddyAllocator( mmu->totalMemory, configData );
+
+    // every run keeps its own clock, PCBs are stamped from the log's
+    procList->clock = &logList->clock;
+    // a replay delivers interrupts by the trace, so needs no I/O threads
+    logList->clock.virtualTime = ( configData->virtualTime ||
+                                   configData->replayFilePath[ 0 ] != NUL )
+                                 ? True : False;
+
     logAction( "System Start", configData, logList );
+    checkSwapFile( mmu, configData, logList );
     runOSStart( mdList, procList, configData, logList );
 
-    runScheduler( configData, procList, logList, mmu );
+    runScheduler( configData, procList, logList, mmu, result );
 
     if( stringCompare( configData->logTo, LOG_TO_FILE ) == 0 ||
         stringCompare( configData->logTo, BOTH )        == 0 )
@@ -67,6 +86,67 @@ void runSimulator( MetadataList *mdList, Config *configData )
     procListDestroy( procList );
 }
 
+//======================================================================
+/**
+* @brief Function resumes a simulation from a checkpoint
+*
+* @details The function restores the configuration, metadata, PCBs, ready
+*   order, memory allocations, log and clock the checkpoint holds, then
+*   runs the scheduler on them as runSimulator() would have carried on.
+*   A resumed run is not traced, its cycle counts would not line up with
+*   the trace's.
+*
+* @param[in] checkpointPath
+*   Path of the checkpoint file
+*
+* @param[out] result
+*   A pointer to a SimResult struct receiving the summary of the run, or
+*   NULL if the caller does not want it
+*
+* @return no error message if the run resumed, otherwise why the
+*   checkpoint could not be read
+*/
+int resumeSimulator( char *checkpointPath, SimResult *result )
+{
+    Config configData;
+    MetadataList *mdList = mdListCreate();
+    ProcessList *procList = procListCreate();
+    LogList *logList = logListCreate();
+    MMUList *mmu = MMUListCreate( 0 );
+    char logStr[ STD_LOG_STR ];
+    int status;
+
+    procList->clock = &logList->clock;
+    status = readCheckpoint( checkpointPath, &configData, mdList, procList,
+                             mmu, logList );
+
+    if( status == NO_ERROR_MSG )
+    {
+        configData.recordFilePath[ 0 ] = NUL;
+        configData.replayFilePath[ 0 ] = NUL;
+
+        snprintf( logStr, STD_LOG_STR, "OS: Resumed from checkpoint %s",
+                  checkpointPath );
+        logAction( logStr, &configData, logList );
+        checkSwapFile( mmu, &configData, logList );
+
+        runScheduler( &configData, procList, logList, mmu, result );
+
+        if( stringCompare( configData.logTo, LOG_TO_FILE ) == 0 ||
+            stringCompare( configData.logTo, BOTH )        == 0 )
+        {
+            logListToFile( &configData, logList );
+        }
+    }
+
+    MMUListDestroy( mmu );
+    logListDestroy( logList );
+    procListDestroy( procList );
+    mdListDestroy( mdList );
+
+    return status;
+}
+
 //======================================================================
 /**
 * @brief Function Begins system, creates PCB list, initializes PCBs to
@@ -114,391 +194,835 @@ void runOSStart( MetadataList *mdList,
 /**
 * @brief Function runs the configured scheduling algorithm
 *
-* @details This function runs the configured scheduling algorithm on the
-*   list of PCBs.
-*
-* @param[in] procList
-*   A pointer to a processList struct storing the created PCBs
+* @details The function creates the scheduler for the configured schedule
+*   code, then runs its policy on one CPU. With more than one CPU
+*   configured, a non-preemptive policy's schedule is instead split
+*   across that many CPUs up front, see runMultiCore(). Preemptive
+*   policies run on one CPU, and say so if more were configured. Finally
+*   the policy's own report, if it has one, and the metrics are logged.
 *
 * @param[in] configData
 *   A pointer to a Config struct storing the given configuration data
 *
+* @param[in] procList
+*   A pointer to a processList struct storing the created PCBs
+*
 * @param[in] logList
 *   A pointer to a logList struct storing the created logs
 *
 * @param[in] mmu
 *   A pointer to an MMUList struct storing allocs
 *
+* @param[out] result
+*   A pointer to a SimResult struct receiving the summary, or NULL
+*
 */
 void runScheduler( Config *configData, ProcessList *procList, LogList *logList,
-                    MMUList *mmu )
+                    MMUList *mmu, SimResult *result )
 {
-    if( stringCompare( configData->scheduleCode, FCFS_N ) == 0 )
+    Scheduler *sched = createScheduler( configData, procList, logList );
+    char logStr[ STD_LOG_STR ];
+    int cpusUsed;
+
+    if( sched == NULL )
     {
-        runFCFS( configData, procList, logList, mmu );
+        return;
     }
-    else if( stringCompare( configData->scheduleCode, SJF_N ) == 0 )
+
+    // preemptive policies are dispatched on one CPU only
+    cpusUsed = sched->preemptive ? 1 : configData->cpuCount;
+    if( configData->cpuCount > cpusUsed )
     {
-        runSJFN( configData, procList, logList, mmu );
+        snprintf( logStr, STD_LOG_STR,
+                  "OS: %s is preemptive, running on 1 of %d CPUs",
+                  sched->name, configData->cpuCount );
+        logAction( logStr, configData, logList );
     }
-    else if( stringCompare( configData->scheduleCode, SRTF_P ) == 0 )
+
+    if( cpusUsed > 1 )
     {
-        runSRTF( configData, procList, logList, mmu );
+        runMultiCore( sched, mmu );
     }
-    else if( stringCompare( configData->scheduleCode, FCFS_P ) == 0 )
+    else
     {
-        runFCFSP( configData, procList, logList, mmu );
+        runDispatcher( sched, mmu );
     }
-    else if( stringCompare( configData->scheduleCode, RR_P ) == 0 )
+
+    if( sched->report != NULL )
     {
-        runRRP( configData, procList, logList, mmu );
+        sched->report( sched );
     }
+    reportMetrics( configData, procList, logList, cpusUsed, result );
+    if( mmu->paging != NULL )
+    {
+        reportPaging( mmu->paging, configData, logList );
+    }
+    if( mmu->buddy != NULL )
+    {
+        reportAllocator( mmu->buddy, configData, logList );
+    }
+    logAction( "System End", configData, logList );
+
+    destroyScheduler( sched );
 }
 
 //======================================================================
 /**
-* @brief Function logs the given logStr to the configured destination
+* @brief Function logs a configured swap file that could not be opened
 *
-* @details The function logs a string to the configured location (file or
-*   monitor), accesses the timer for when the log is happening and prepends
-*   the time to the log string.
+* @details The run goes on without swapping.
 *
-* @param[in] logStr
-*   A char pointer to the string desired to be logged
+* @param[in] mmu
+*   A pointer to the MMUList holding the paging unit
 *
 * @param[in] configData
 *   A pointer to a Config struct storing the given configuration data
 *
 * @param[in] logList
 *   A pointer to a logList struct storing the created logs
+*
 */
-void logAction( char *logStr, Config *configData, LogList *logList )
+void checkSwapFile( MMUList *mmu, Config *configData, LogList *logList )
 {
-	char *currTime = malloc( 10 );
-    char *properLogStr = malloc( STD_LOG_STR );
-
-    if( stringCompare( logStr, "System Start" ) == 0 )
-    {
-        accessTimer( ZERO_TIMER, currTime );
-    }
-    else if( stringCompare( logStr, "System End" ) == 0 )
-    {
-        accessTimer( STOP_TIMER, currTime );
-    }
-    else
-    {
-        accessTimer( LAP_TIMER, currTime );
-    }
-
-    snprintf( properLogStr, STD_LOG_STR, "Time: %s, %s\n",
-              currTime, logStr );
-    addLogNode( logList, createLogNode( properLogStr ) );
+    char logStr[ STD_LOG_STR ];
 
-    if( stringCompare( configData->logTo, MONITOR ) == 0 ||
-        stringCompare( configData->logTo, BOTH )    == 0 )
+    if( mmu->paging != NULL && configData->swapFilePath[ 0 ] != NUL &&
+        mmu->paging->swapFile == NULL )
     {
-        printf( "Time: %s, %s\n", currTime, logStr );
+        snprintf( logStr, STD_LOG_STR,
+                  "OS: Could not open swap file %s, running without swap",
+                  configData->swapFilePath );
+        logAction( logStr, configData, logList );
     }
-    free( properLogStr );
-    free( currTime );
-    return;
 }
 
 //======================================================================
 /**
-* @brief Function runs FirstComeFirstServed scheduling on the given
-*   list of process control blocks.
+* @brief Function dispatches processes on one CPU until all have exited
 *
-* @details The function chooses a PCB from the list, sets it to RUNNING,
-*   then begins processes each opCode within. For each opCode, it logs
-*   the operation, then if it is I/O or processing, it creates a thread
-*   to run for the given time, and logs the start and end. When the PCB
-*   is done, it sets the process to EXIT and moves to the next one.
+* @details The function asks the scheduler for the next Ready process,
+*   sets it Running and runs its opCodes, preemptively or to completion
+*   as the policy requires. With nothing Ready, the CPU idles until an
+*   I/O interrupt readies a process. Between dispatches no process is
+*   running, so that is where checkpoints are written, when signalled or
+*   once the configured interval has passed. A resumed run starts with
+*   some PCBs Blocked, their I/O is posted again first.
 *
-* @param[in] procList
-*   A pointer to a processList struct storing the created PCBs
-*
-* @param[in] configData
-*   A pointer to a Config struct storing the given configuration data
-*
-* @param[in] logList
-*   A pointer to a logList struct storing the created logs
+* @param[in] sched
+*   A pointer to the Scheduler for the configured policy
 *
 * @param[in] mmu
 *   A pointer to an MMUList struct storing allocs
 *
 */
-void runFCFS( Config *configData, ProcessList *procList, LogList *logList,
-                MMUList *mmu )
+void runDispatcher( Scheduler *sched, MMUList *mmu )
 {
-    ProcessControlBlock *currBlock = procListFirst( procList );
+    Config *configData = sched->configData;
+    ProcessList *procList = sched->procList;
+    LogList *logList = sched->logList;
+    ProcessControlBlock *currBlock = NULL;
     char logStr[ STD_LOG_STR ];
+    char timeStr[ 20 ];
+	InterruptQueue *intQueue = createInterruptQueue();
+	int status;
+	double idleStart = -1.0;
+	double nextCheckpoint = accessTimer( &logList->clock, LAP_TIMER, timeStr )
+							+ configData->checkpointInterval / 1000.0;
+
+	intQueue->trace = createIntTrace( configData->recordFilePath,
+									  configData->replayFilePath, &status );
+	if( status != NO_ERROR_MSG )
+	{
+		snprintf( logStr, STD_LOG_STR,
+				  "OS: Could not open interrupt trace, running untraced" );
+		logAction( logStr, configData, logList );
+	}
 
-    while( currBlock != NULL )
+	intQueue->batchSize = configData->intBatchSize;
+	intQueue->batchDelay = configData->intBatchDelay;
+	intQueue->mmu = mmu;
+	resumeBlockedIO( intQueue, configData, logList, procList );
+
+	// while there is at least one process not in EXIT
+    while( listEmpty( procList ) == 0 )
     {
-        snprintf( logStr, STD_LOG_STR,
-                  "OS: FCFS-N Strategy selects Process %d with time: %d mSec",
-                  currBlock->pid, currBlock->processTime );
+		if( checkpointDue( configData,
+				accessTimer( &logList->clock, LAP_TIMER, timeStr ),
+				&nextCheckpoint ) )
+		{
+			status = writeCheckpoint( configData->checkpointFilePath,
+									  sched, mmu );
+			snprintf( logStr, STD_LOG_STR, status == NO_ERROR_MSG ?
+					  "OS: Checkpoint written to %s" :
+					  "OS: Could not write checkpoint %s",
+					  configData->checkpointFilePath );
+			logAction( logStr, configData, logList );
+		}
+
+		currBlock = sched->pickNext( sched );
+
+		// this is used for CPU idle, ie waiting for pcbs to go to READY
+		if( currBlock == NULL )
+		{
+			if( idleStart < 0.0 )
+			{
+				idleStart = accessTimer( &logList->clock, LAP_TIMER,
+										 timeStr );
+			}
+
+			// a virtual clock skips the idle time to the next interrupt
+			if( logList->clock.virtualTime == True )
+			{
+				if( nextIntTime( intQueue ) >
+					accessTimer( &logList->clock, LAP_TIMER, timeStr ) )
+				{
+					setClockTime( &logList->clock, nextIntTime( intQueue ) );
+				}
+			}
+			// nothing can be Ready until an I/O thread posts, so sleep
+			else if( nextIntTime( intQueue ) < 0.0 &&
+					 procStateCount( procList, BLOCKED ) > 0 )
+			{
+				waitForPosted( intQueue );
+			}
+			checkForInterrupts( currBlock, intQueue, logStr, configData,
+								logList, procList );
+			continue;
+		}
+
+		if( idleStart >= 0.0 )
+		{
+			snprintf( logStr, STD_LOG_STR, "OS: CPU Idle for %.3f mSec",
+					  ( accessTimer( &logList->clock, LAP_TIMER, timeStr )
+					  - idleStart ) * 1000.0 );
+			logAction( logStr, configData, logList );
+			idleStart = -1.0;
+		}
+
+		snprintf( logStr, STD_LOG_STR,
+                  "OS: %s Strategy selects Process %d with time: %d mSec",
+                  sched->name, currBlock->pid, currBlock->processTime );
         logAction( logStr, configData, logList );
 
-        currBlock->state = RUN;
+        setPCBState( procList, currBlock, RUN );
         snprintf( logStr, STD_LOG_STR,
                   "OS: Process %d set in Running state", currBlock->pid );
         logAction( logStr, configData, logList );
 
-        processOpCodesNonpreemptive( currBlock->processHead, configData, logList, currBlock,
-                        logStr, mmu );
+		if( sched->preemptive )
+		{
+	        processOpCodesPreemptive( configData, logList, currBlock, logStr,
+									mmu, intQueue, procList, sched );
+		}
+		else
+		{
+	        processOpCodesNonpreemptive( currBlock->processHead, configData,
+									logList, currBlock, logStr, mmu );
 
-        endProcess( mmu, currBlock );
-        snprintf( logStr, STD_LOG_STR,
-                  "OS: Process %d set in Exit state", currBlock->pid );
-        logAction( logStr, configData, logList );
-        currBlock = currBlock->next;
+	        endProcess( mmu, procList, currBlock );
+	        snprintf( logStr, STD_LOG_STR,
+	                  "OS: Process %d set in Exit state", currBlock->pid );
+	        logAction( logStr, configData, logList );
+		}
     }
 
-    logAction( "System End", configData, logList );
-
-    return;
+	if( configData->intBatchSize > 1 || configData->intBatchDelay > 0 )
+	{
+		reportIntBatches( intQueue, configData, logList );
+	}
+	destroyInterruptQueue( intQueue );
 }
 
 //======================================================================
 /**
-* @brief Function runs ShortestJobFirst scheduling on the given
-*   list of process control blocks.
+* @brief Function logs how many interrupts were delivered per batch
 *
-* @details The function organizes the process list by SJF, and begins running.
+* @details One line is logged per batch size seen, the last size also
+*   counting every larger batch, so the effect of coalescing can be read
+*   from the log.
 *
-* @param[in] procList
-*   A pointer to a processList struct storing the created PCBs
+* @param[in] intQueue
+*   A pointer to the InterruptQueue the batches were counted in
 *
 * @param[in] configData
-*   A pointer to a Config struct storing the given configuration data
+*   A pointer to the Config struct
 *
 * @param[in] logList
-*   A pointer to a logList struct storing the created logs
+*   A pointer to the LogList
 *
-* @param[in] mmu
-*   A pointer to an MMUList struct storing allocs
+*/
+void reportIntBatches( InterruptQueue *intQueue, Config *configData,
+					   LogList *logList )
+{
+	char logStr[ STD_LOG_STR ];
+	int size;
+
+	for( size = 1; size <= INT_BATCH_BUCKETS; size++ )
+	{
+		if( intQueue->batchCounts[ size - 1 ] > 0 )
+		{
+			snprintf( logStr, STD_LOG_STR,
+					  "OS: Interrupt batches of %d%s: %d", size,
+					  size == INT_BATCH_BUCKETS ? " or more" : "",
+					  intQueue->batchCounts[ size - 1 ] );
+			logAction( logStr, configData, logList );
+		}
+	}
+}
+
+//======================================================================
+/**
+* @brief Function logs how the TLB and page tables did over the run
+*
+* @details With a swap file, the pages swapped in and out are logged as
+*   totals and as rates per second of the run, and the swap file's
+*   failed page moves if there were any.
+*
+* @param[in] paging
+*   A pointer to the paging unit the lookups were counted in
+*
+* @param[in] configData
+*   A pointer to the Config struct
+*
+* @param[in] logList
+*   A pointer to the LogList
 *
 */
-void runSJFN( Config *configData, ProcessList *procList, LogList *logList,
-                MMUList *mmu )
+void reportPaging( Paging *paging, Config *configData, LogList *logList )
 {
-    ProcessControlBlock *currBlock = findShortestJob( procList );
-    char logStr[ STD_LOG_STR ];
+	char logStr[ STD_LOG_STR ];
+	char timeStr[ 20 ];
+	double runTime;
 
-    while( currBlock != NULL )
-    {
-        snprintf( logStr, STD_LOG_STR,
-                  "OS: SJF-N Strategy selects Process %d with time: %d mSec",
-                  currBlock->pid, currBlock->processTime );
-        logAction( logStr, configData, logList );
+	snprintf( logStr, STD_LOG_STR,
+			  "OS: TLB of %d sets x %d ways: %ld hits, %ld misses "
+			  "(%.1f%% hit rate)", paging->tlbSets, paging->tlbWays,
+			  paging->tlbHits, paging->tlbMisses,
+			  paging->lookups > 0 ? 100.0 * paging->tlbHits
+								   / paging->lookups : 0.0 );
+	logAction( logStr, configData, logList );
 
-        currBlock->state = RUN;
-        snprintf( logStr, STD_LOG_STR,
-                  "OS: Process %d set in Running state", currBlock->pid );
-        logAction( logStr, configData, logList );
+	snprintf( logStr, STD_LOG_STR,
+			  "OS: %d KB pages: %ld page faults, %d of %d frames free",
+			  paging->pageSize, paging->pageFaults, paging->freeCount,
+			  paging->numFrames );
+	logAction( logStr, configData, logList );
 
-        processOpCodesNonpreemptive( currBlock->processHead, configData, logList, currBlock,
-                        logStr, mmu );
+	if( paging->swapFile != NULL )
+	{
+		runTime = accessTimer( &logList->clock, LAP_TIMER, timeStr );
+		snprintf( logStr, STD_LOG_STR,
+				  "OS: Swap: %ld pages in (%.1f/sec), %ld out (%.1f/sec), "
+				  "%d slots", paging->swapIns,
+				  runTime > 0.0 ? paging->swapIns / runTime : 0.0,
+				  paging->swapOuts,
+				  runTime > 0.0 ? paging->swapOuts / runTime : 0.0,
+				  paging->slotCount );
+		logAction( logStr, configData, logList );
 
-        endProcess( mmu, currBlock );
-        snprintf( logStr, STD_LOG_STR,
-                  "OS: Process %d set in Exit state", currBlock->pid );
-        logAction( logStr, configData, logList );
+		if( paging->swapErrors > 0 )
+		{
+			snprintf( logStr, STD_LOG_STR,
+					  "OS: Swap file %s failed on %ld page moves",
+					  paging->swapFilePath, paging->swapErrors );
+			logAction( logStr, configData, logList );
+		}
+	}
+}
 
-        currBlock = findShortestJob( procList );
-    }
+//======================================================================
+/**
+* @brief Function logs how well the buddy allocator placed allocations
+*
+* @details Internal fragmentation is the share of the blocks handed out
+*   that was not asked for, external the mean and worst share of free
+*   memory outside the largest free block as requests came in. Latency
+*   is in allocator steps, orders looked at plus blocks split.
+*
+* @param[in] buddy
+*   A pointer to the allocator the requests were counted in
+*
+* @param[in] configData
+*   A pointer to the Config struct
+*
+* @param[in] logList
+*   A pointer to the LogList
+*
+*/
+void reportAllocator( BuddyAllocator *buddy, Config *configData,
+					  LogList *logList )
+{
+	char logStr[ STD_LOG_STR ];
+	long placed = buddy->requests - buddy->failures;
 
-    logAction( "System End", configData, logList );
+	snprintf( logStr, STD_LOG_STR,
+			  "OS: Buddy allocator: %ld requests, %ld failed (%.1f%%), "
+			  "%ld of them for fragmentation", buddy->requests,
+			  buddy->failures, buddy->requests > 0 ?
+			  100.0 * buddy->failures / buddy->requests : 0.0,
+			  buddy->fragFailures );
+	logAction( logStr, configData, logList );
 
-    return;
+	snprintf( logStr, STD_LOG_STR,
+			  "OS: Internal fragmentation %.1f%% (%ld KB asked for, "
+			  "%ld KB given)", buddy->grantedKB > 0 ? 100.0
+			  * ( buddy->grantedKB - buddy->requestedKB )
+			  / buddy->grantedKB : 0.0,
+			  buddy->requestedKB, buddy->grantedKB );
+	logAction( logStr, configData, logList );
+
+	snprintf( logStr, STD_LOG_STR,
+			  "OS: External fragmentation %.1f%% mean, %.1f%% worst",
+			  buddy->requests > 0 ?
+			  100.0 * buddy->extFragSum / buddy->requests : 0.0,
+			  100.0 * buddy->extFragMax );
+	logAction( logStr, configData, logList );
+
+	snprintf( logStr, STD_LOG_STR,
+			  "OS: Allocation latency %.2f steps mean, %ld worst",
+			  placed > 0 ? ( double )buddy->totalSteps / placed : 0.0,
+			  buddy->maxSteps );
+	logAction( logStr, configData, logList );
 }
 
 //======================================================================
 /**
-* @brief
+* @brief Function logs the per-process metrics table and its summary
 *
-* @details
-*
-* @param[in] procList
-*   A pointer to a processList struct storing the created PCBs
+* @details The function logs one row per process of the times recorded as
+*   it changed state, then the mean and 50th, 95th and 99th percentile of
+*   each column and the CPU utilization. All times are milliseconds from
+*   System Start. If a metrics file is configured, the same values are
+*   written to it as CSV.
 *
 * @param[in] configData
 *   A pointer to a Config struct storing the given configuration data
 *
+* @param[in] procList
+*   A pointer to a processList struct storing the created PCBs
+*
 * @param[in] logList
 *   A pointer to a logList struct storing the created logs
 *
-* @param[in] mmu
-*   A pointer to an MMUList struct storing allocs
+* @param[in] cpusUsed
+*   The number of CPUs the run was spread over
 *
+* @param[out] result
+*   A pointer to a SimResult struct receiving the makespan, the mean
+*   turnaround and response times and the CPU utilization, or NULL
 */
-void runSRTF( Config *configData, ProcessList *procList, LogList *logList,
-                MMUList *mmu )
+void reportMetrics( Config *configData, ProcessList *procList,
+                    LogList *logList, int cpusUsed, SimResult *result )
 {
-    ProcessControlBlock *currBlock = NULL;
+    ProcessControlBlock *currBlock = procListFirst( procList );
+    MetricSummary summary[ NUM_METRICS ];
     char logStr[ STD_LOG_STR ];
-	InterruptQueue *intQueue = createInterruptQueue();
-
-    while( listEmpty( procList ) == 0 )
-    {
-		// selecting Processes for SRTF-P
-		currBlock = findShortestJob( procList );
+    char timeStr[ 20 ];
+    double makespan = accessTimer( &logList->clock, LAP_TIMER, timeStr );
+    const char *rowNames[] = { "avg", "p50", "p95", "p99" };
+    double *rowValues[ NUM_METRICS ];
+    int metric, row;
 
-		// this is used for CPU idle, ie waiting for pcbs to go to READY
-		if( currBlock == NULL )
-		{
-			checkForInterrupts( currBlock, intQueue, logStr, configData,
-								logList, NULL, NULL );
-			continue;
-		}
+    logAction( "OS: Process metrics (msec)", configData, logList );
+    logAction( "OS: PID   Arrival  FirstRun  Complete  Turnaround"
+               "  Response  ReadyWait  Blocked", configData, logList );
 
-		snprintf( logStr, STD_LOG_STR,
-                  "OS: SRTF-P Strategy selects Process %d with time: %d mSec",
-                  currBlock->pid, currBlock->processTime );
+    while( currBlock != NULL )
+    {
+        snprintf( logStr, STD_LOG_STR,
+                  "OS: %3d  %8.1f  %8.1f  %8.1f  %10.1f  %8.1f  %9.1f  %7.1f",
+                  currBlock->pid, pcbMetric( currBlock, ARRIVAL ),
+                  pcbMetric( currBlock, FIRST_RUN ),
+                  pcbMetric( currBlock, COMPLETION ),
+                  pcbMetric( currBlock, TURNAROUND ),
+                  pcbMetric( currBlock, RESPONSE ),
+                  pcbMetric( currBlock, READY_WAIT ),
+                  pcbMetric( currBlock, BLOCKED_TIME ) );
         logAction( logStr, configData, logList );
+        currBlock = currBlock->next;
+    }
 
-        currBlock->state = RUN;
+    for( metric = 0; metric < NUM_METRICS; metric++ )
+    {
+        summarizeMetric( procList, metric, &summary[ metric ] );
+    }
+    for( row = 0; row < 4; row++ )
+    {
+        for( metric = 0; metric < NUM_METRICS; metric++ )
+        {
+            rowValues[ metric ] = row == 0 ? &summary[ metric ].mean :
+                                  row == 1 ? &summary[ metric ].p50 :
+                                  row == 2 ? &summary[ metric ].p95 :
+                                             &summary[ metric ].p99;
+        }
         snprintf( logStr, STD_LOG_STR,
-                  "OS: Process %d set in Running state", currBlock->pid );
+                  "OS: %s  %8.1f  %8.1f  %8.1f  %10.1f  %8.1f  %9.1f  %7.1f",
+                  rowNames[ row ], *rowValues[ ARRIVAL ],
+                  *rowValues[ FIRST_RUN ], *rowValues[ COMPLETION ],
+                  *rowValues[ TURNAROUND ], *rowValues[ RESPONSE ],
+                  *rowValues[ READY_WAIT ], *rowValues[ BLOCKED_TIME ] );
         logAction( logStr, configData, logList );
-
-        processOpCodesPreemptive( configData, logList, currBlock, logStr, mmu,
-		 							intQueue, procList, NULL );
     }
 
-    logAction( "System End", configData, logList );
+    snprintf( logStr, STD_LOG_STR,
+              "OS: CPU utilization %.1f%% over %.1f msec on %d CPU(s)",
+              cpuUtilization( procList, makespan, cpusUsed ),
+              makespan * 1000.0, cpusUsed );
+    logAction( logStr, configData, logList );
 
-    return;
+    if( result != NULL )
+    {
+        result->processes = procListCount( procList );
+        result->makespan = makespan * 1000.0;
+        result->meanTurnaround = summary[ TURNAROUND ].mean;
+        result->meanResponse = summary[ RESPONSE ].mean;
+        result->cpuUtilization = cpuUtilization( procList, makespan,
+                                                 cpusUsed );
+        result->segFaults = 0;
+        for( currBlock = procListFirst( procList ); currBlock != NULL;
+             currBlock = currBlock->next )
+        {
+            result->segFaults += currBlock->segFaulted;
+        }
+    }
+
+    if( configData->metricsFilePath[ 0 ] != NUL &&
+        writeMetricsFile( configData->metricsFilePath, procList, makespan,
+                          cpusUsed ) != NO_ERROR_MSG )
+    {
+        snprintf( logStr, STD_LOG_STR,
+                  "OS: Could not write metrics file %s",
+                  configData->metricsFilePath );
+        logAction( logStr, configData, logList );
+    }
 }
 
 //======================================================================
 /**
-* @brief
+* @brief Function logs the given logStr to the configured destination
 *
-* @details
+* @details The function logs a string to the configured location (file or
+*   monitor), accesses the timer for when the log is happening and prepends
+*   the time to the log string.
 *
-* @param[in] procList
-*   A pointer to a processList struct storing the created PCBs
+* @param[in] logStr
+*   A char pointer to the string desired to be logged
 *
 * @param[in] configData
 *   A pointer to a Config struct storing the given configuration data
 *
 * @param[in] logList
 *   A pointer to a logList struct storing the created logs
+*/
+void logAction( char *logStr, Config *configData, LogList *logList )
+{
+	char currTime[ 20 ];
+    char properLogStr[ STD_LOG_STR ];
+
+    // several CPUs may log at once, keep each line's time and order together
+    pthread_mutex_lock( &logList->lock );
+
+    if( stringCompare( logStr, "System Start" ) == 0 )
+    {
+        accessTimer( &logList->clock, ZERO_TIMER, currTime );
+    }
+    else if( stringCompare( logStr, "System End" ) == 0 )
+    {
+        accessTimer( &logList->clock, STOP_TIMER, currTime );
+    }
+    else
+    {
+        accessTimer( &logList->clock, LAP_TIMER, currTime );
+    }
+
+    snprintf( properLogStr, STD_LOG_STR, "Time: %s, %s\n",
+              currTime, logStr );
+    addLogNode( logList, createLogNode( properLogStr ) );
+
+    if( stringCompare( configData->logTo, MONITOR ) == 0 ||
+        stringCompare( configData->logTo, BOTH )    == 0 )
+    {
+        printf( "Time: %s, %s\n", currTime, logStr );
+    }
+
+    pthread_mutex_unlock( &logList->lock );
+    return;
+}
+
+//======================================================================
+/**
+* @brief Function runs a static partition of a non-preemptive schedule on
+*   more than one simulated CPU
+*
+* @details The function takes the whole schedule from the scheduler before
+*   any CPU starts, in the order one CPU would have run it, and deals the
+*   PCBs out to each CPU's deque in turn. The policy is not consulted
+*   again, so this only suits policies that never preempt and whose order
+*   is fixed once every PCB is Ready. One dispatcher thread per CPU then
+*   works through its deque, and a CPU whose deque runs dry steals from
+*   the others, which evens out the split but never reorders it. When
+*   every dispatcher is done, the per-CPU utilization and the makespan
+*   are logged.
+*
+* @param[in] sched
+*   A pointer to the Scheduler for the configured policy
 *
 * @param[in] mmu
 *   A pointer to an MMUList struct storing allocs
 *
 */
-void runFCFSP( Config *configData, ProcessList *procList, LogList *logList,
-                MMUList *mmu )
+void runMultiCore( Scheduler *sched, MMUList *mmu )
 {
-	ProcessControlBlock *currBlock = NULL;
+    Config *configData = sched->configData;
+    ProcessList *procList = sched->procList;
+    LogList *logList = sched->logList;
+    MultiCore system;
+    ProcessControlBlock *currBlock = NULL;
     char logStr[ STD_LOG_STR ];
-	InterruptQueue *intQueue = createInterruptQueue();
+    char timeStr[ 20 ];
+    int numCores = configData->cpuCount;
+    int index = 0;
+    double makespan;
+
+    system.numCores = numCores;
+    system.configData = configData;
+    system.procList = procList;
+    system.logList = logList;
+    system.mmu = mmu;
+    system.cores = malloc( sizeof( CPUCore ) * numCores );
+
+    for( index = 0; index < numCores; index++ )
+    {
+        system.cores[ index ].coreId = index;
+        system.cores[ index ].busyTime = 0.0;
+        system.cores[ index ].processesRun = 0;
+        system.cores[ index ].processesStolen = 0;
+        system.cores[ index ].system = &system;
+        initWorkDeque( &system.cores[ index ].deque,
+                       procListCount( procList ) / numCores + 1 );
+    }
 
-    while( listEmpty( procList ) == 0 )
+    // deal PCBs out in the order the single CPU would have run them
+    index = 0;
+    while( ( currBlock = sched->pickNext( sched ) ) != NULL )
     {
-		// selecting Processes for FCFS-P
-		currBlock = getNextReady( procList );
+        pushWork( &system.cores[ index++ % numCores ].deque, currBlock );
+    }
 
-		// this is used for CPU idle, ie waiting for pcbs to go to READY
-		if( currBlock == NULL )
-		{
-			checkForInterrupts( currBlock, intQueue, logStr, configData,
-								logList, NULL, NULL );
-			continue;
-		}
+    if( logList->clock.virtualTime == True )
+    {
+        runCoresVirtual( &system );
+    }
+    else
+    {
+        for( index = 0; index < numCores; index++ )
+        {
+            pthread_create( &system.cores[ index ].tid, NULL, runCPUCore,
+                            &system.cores[ index ] );
+        }
+        for( index = 0; index < numCores; index++ )
+        {
+            pthread_join( system.cores[ index ].tid, NULL );
+        }
+    }
 
-		snprintf( logStr, STD_LOG_STR,
-                  "OS: FCFS-P Strategy selects Process %d with time: %d mSec",
-                  currBlock->pid, currBlock->processTime );
-        logAction( logStr, configData, logList );
+    makespan = accessTimer( &logList->clock, LAP_TIMER, timeStr );
 
-        currBlock->state = RUN;
+    for( index = 0; index < numCores; index++ )
+    {
         snprintf( logStr, STD_LOG_STR,
-                  "OS: Process %d set in Running state", currBlock->pid );
+                  "OS: CPU %d ran %d processes ( %d stolen ), "
+                  "utilization %.1f%%",
+                  index, system.cores[ index ].processesRun,
+                  system.cores[ index ].processesStolen,
+                  makespan > 0.0 ?
+                  100.0 * system.cores[ index ].busyTime / makespan : 0.0 );
         logAction( logStr, configData, logList );
-
-        processOpCodesPreemptive( configData, logList, currBlock, logStr, mmu,
-		 							intQueue, procList, NULL );
+        freeWorkDeque( &system.cores[ index ].deque );
     }
+    snprintf( logStr, STD_LOG_STR, "OS: Makespan %.6f sec on %d CPUs",
+              makespan, numCores );
+    logAction( logStr, configData, logList );
 
-    logAction( "System End", configData, logList );
+    free( system.cores );
 
     return;
 }
 
 //======================================================================
 /**
-* @brief
+* @brief Function is the dispatcher thread for one simulated CPU
 *
-* @details
+* @details The function runs processes on its CPU until there are none
+*   left to take or steal. It returns once no CPU has work left, since
+*   nothing becomes Ready again under the non-preemptive algorithms.
 *
-* @param[in] procList
-*   A pointer to a processList struct storing the created PCBs
+* @param[in] core
+*   A pointer to the CPUCore struct for this CPU
 *
-* @param[in] configData
-*   A pointer to a Config struct storing the given configuration data
+*/
+void *runCPUCore( void *core )
+{
+    CPUCore *cpu = ( CPUCore * )( core );
+
+    while( runNextOnCore( cpu ) )
+    {
+        continue;
+    }
+
+    return NULL;
+}
+
+//======================================================================
+/**
+* @brief Function runs the CPUs of a virtual clock run one at a time
 *
-* @param[in] logList
-*   A pointer to a logList struct storing the created logs
+* @details The function stands in for the dispatcher threads when the
+*   clock is virtual. The CPU that frees up earliest runs its next
+*   process to completion from the time it freed up, with the lowest
+*   numbered CPU going first on a tie, until no CPU has work left. Each
+*   process's log lines and times are exact, but a process's lines are
+*   all logged before the next CPU's process starts, so the log is not
+*   in time order across CPUs. Sort it on the time column to see the
+*   CPUs side by side.
 *
-* @param[in] mmu
-*   A pointer to an MMUList struct storing allocs
+* @param[in] system
+*   A pointer to the MultiCore struct for the run
 *
 */
-void runRRP( Config *configData, ProcessList *procList, LogList *logList,
-                MMUList *mmu )
+void runCoresVirtual( MultiCore *system )
 {
-	ProcessControlBlock *currBlock = procListFirst( procList );
-    char logStr[ STD_LOG_STR ];
-	InterruptQueue *intQueue = createInterruptQueue();
-	ReadyQueue *ready = createReadyQueue();
+    SimClock *clock = &system->logList->clock;
+    char timeStr[ 20 ];
+    double *freeAt = malloc( sizeof( double ) * system->numCores );
+    double endTime = accessTimer( clock, LAP_TIMER, timeStr );
+    int index, nextCore, active = system->numCores;
 
-	while( currBlock != NULL )
-	{
-		enqueuePCB( ready, currBlock );
-		currBlock = currBlock->next;
-	}
+    for( index = 0; index < system->numCores; index++ )
+    {
+        freeAt[ index ] = endTime;
+    }
 
-	// while there is at least one process not in EXIT
-    while( listEmpty( procList ) == 0 )
+    while( active > 0 )
     {
-		// selecting Processes for FCFS-P
-		currBlock = dequeuePCB( ready );
-		if( currBlock == NULL && ready == NULL )
-		{
-			currBlock = getNextReady( procList );
-		}
+        nextCore = -1;
+        for( index = 0; index < system->numCores; index++ )
+        {
+            if( freeAt[ index ] >= 0.0 &&
+                ( nextCore < 0 || freeAt[ index ] < freeAt[ nextCore ] ) )
+            {
+                nextCore = index;
+            }
+        }
 
-		// this is used for CPU idle, ie waiting for pcbs to go to READY
-		if( currBlock == NULL )
-		{
-			checkForInterrupts( currBlock, intQueue, logStr, configData,
-								logList, ready, procList );
-			continue;
-		}
+        setClockTime( clock, freeAt[ nextCore ] );
+        if( runNextOnCore( &system->cores[ nextCore ] ) )
+        {
+            freeAt[ nextCore ] = accessTimer( clock, LAP_TIMER, timeStr );
+            if( freeAt[ nextCore ] > endTime )
+            {
+                endTime = freeAt[ nextCore ];
+            }
+        }
+        else
+        {
+            // a CPU with nothing to take or steal is done for good
+            freeAt[ nextCore ] = -1.0;
+            active--;
+        }
+    }
 
-		snprintf( logStr, STD_LOG_STR,
-                  "OS: RR-P Strategy selects Process %d with time: %d mSec",
-                  currBlock->pid, currBlock->processTime );
-        logAction( logStr, configData, logList );
+    setClockTime( clock, endTime );
+    free( freeAt );
+}
 
-        currBlock->state = RUN;
-        snprintf( logStr, STD_LOG_STR,
-                  "OS: Process %d set in Running state", currBlock->pid );
-        logAction( logStr, configData, logList );
+//======================================================================
+/**
+* @brief Function runs one process to completion on a simulated CPU
+*
+* @details The function takes a PCB from the CPU's own deque, or steals
+*   one from another CPU when its own is empty, and runs it to Exit.
+*
+* @param[in] cpu
+*   A pointer to the CPUCore struct for this CPU
+*
+* @return 1 if a process ran, 0 if there was none to take or steal
+*/
+int runNextOnCore( CPUCore *cpu )
+{
+    MultiCore *system = cpu->system;
+    ProcessControlBlock *currBlock;
+    char logStr[ STD_LOG_STR ];
+    char timeStr[ 20 ];
+    double startTime;
 
-        processOpCodesPreemptive( configData, logList, currBlock, logStr, mmu,
-		 							intQueue, procList, ready );
+    currBlock = takeWork( &cpu->deque );
+    if( currBlock == NULL )
+    {
+        currBlock = stealForCore( cpu );
+        if( currBlock == NULL )
+        {
+            return 0;
+        }
+        cpu->processesStolen++;
     }
 
-    logAction( "System End", configData, logList );
+    startTime = accessTimer( &system->logList->clock, LAP_TIMER, timeStr );
 
-    return;
+    snprintf( logStr, STD_LOG_STR,
+              "OS: CPU %d, %s Strategy selects Process %d "
+              "with time: %d mSec", cpu->coreId,
+              system->configData->scheduleCode,
+              currBlock->pid, currBlock->processTime );
+    logAction( logStr, system->configData, system->logList );
+
+    setPCBState( system->procList, currBlock, RUN );
+    snprintf( logStr, STD_LOG_STR,
+              "OS: Process %d set in Running state on CPU %d",
+              currBlock->pid, cpu->coreId );
+    logAction( logStr, system->configData, system->logList );
+
+    processOpCodesNonpreemptive( currBlock->processHead,
+                    system->configData, system->logList, currBlock,
+                    logStr, system->mmu );
+
+    endProcess( system->mmu, system->procList, currBlock );
+    snprintf( logStr, STD_LOG_STR,
+              "OS: Process %d set in Exit state", currBlock->pid );
+    logAction( logStr, system->configData, system->logList );
+
+    cpu->busyTime += accessTimer( &system->logList->clock, LAP_TIMER,
+                                  timeStr ) - startTime;
+    cpu->processesRun++;
+
+    return 1;
+}
+
+//======================================================================
+/**
+* @brief Function steals a PCB for an idle CPU
+*
+* @details The function tries every other CPU once, starting with the
+*   next one up, so thieves spread across victims instead of all hitting
+*   CPU 0.
+*
+* @param[in] cpu
+*   A pointer to the CPUCore struct for the idle CPU
+*
+* @return a stolen PCB, or NULL if every other CPU is out of work
+*/
+ProcessControlBlock *stealForCore( CPUCore *cpu )
+{
+    MultiCore *system = cpu->system;
+    ProcessControlBlock *stolen = NULL;
+    int offset;
+
+    for( offset = 1; offset < system->numCores && stolen == NULL; offset++ )
+    {
+        stolen = stealWork( &system->cores[
+                    ( cpu->coreId + offset ) % system->numCores ].deque );
+    }
+    return stolen;
 }
 
 //======================================================================
@@ -529,43 +1053,193 @@ void logListToFile( Config *configData, LogList *logList )
     closeFile( logFile );
 }
 
+//======================================================================
+/**
+* @brief Function posts the I/O interrupts of PCBs already Blocked
+*
+* @details Only a resumed run starts with Blocked PCBs. Each one's I/O
+*   was charged before the checkpoint, so only its interrupt is posted
+*   again, for the I/O's due time. They are posted oldest first, as they
+*   were first posted.
+*
+* @param[in] intQueue
+*   A pointer to the InterruptQueue
+*
+* @param[in] configData
+*   A pointer to the Config struct
+*
+* @param[in] logList
+*   A pointer to the LogList
+*
+* @param[in] procList
+*   A pointer to the ProcessList
+*/
+void resumeBlockedIO( InterruptQueue *intQueue, Config *configData,
+					  LogList *logList, ProcessList *procList )
+{
+	ProcessControlBlock *currBlock = procStateFirst( procList, BLOCKED );
+	char timeStr[ 20 ];
+	double currTime = accessTimer( &logList->clock, LAP_TIMER, timeStr );
+	int waitTime;
+
+	// the Blocked set is newest first
+	while( currBlock != NULL && currBlock->nextInState != NULL )
+	{
+		currBlock = currBlock->nextInState;
+	}
+	while( currBlock != NULL )
+	{
+		waitTime = ( int )( ( currBlock->ioDueTime - currTime ) * 1000.0 );
+		postIOInterrupt( buildThreadContainer( configData, logList, intQueue,
+							currBlock, waitTime > 0 ? waitTime : 0 ) );
+		currBlock = currBlock->prevInState;
+	}
+}
+
 //======================================================================
 /**
 * @brief Function creates a POSIX thread and runs it for the given time.
 *
 * @details The function casts the given time to a void pointer, creates
-*   a thread, and has the thread run the timer for the given time.
+*   a thread, and has the thread run the timer for the given time. A
+*   virtual clock is just moved on by the time instead.
+*
+* @param[in] clock
+*   A pointer to the SimClock of this simulation
 *
 * @param[in] threadTime
 *   A integer representing the milliseconds to run the thread for.
 */
-void runNonpreemptiveThread( int threadTime )
+void runNonpreemptiveThread( SimClock *clock, int threadTime )
 {
     int *runTime = &threadTime;
     pthread_t tid;
 
-    pthread_create( &tid, NULL, runTimer, (void *)runTime );
-    pthread_join( tid, NULL );
+    if( clock->virtualTime == True )
+    {
+        advanceClock( clock, threadTime );
+        return;
+    }
+
+    pthread_create( &tid, NULL, runTimer, (void *)runTime );
+    pthread_join( tid, NULL );
+
+    return;
+}
+
+//======================================================================
+/**
+* @brief Function runs a process's I/O on the calling thread
+*
+* @details A non-preemptive process stays Running through its I/O, but
+*   the CPU is not busy with it, so the time is charged to the process as
+*   blocked rather than run time.
+*
+* @param[in] currBlock
+*   A pointer to the ProcessControlBlock doing the I/O
+*
+* @param[in] clock
+*   A pointer to the SimClock of this simulation
+*
+* @param[in] ioTime
+*   An integer representing the milliseconds the I/O takes
+*/
+void runNonpreemptiveIO( ProcessControlBlock *currBlock, SimClock *clock,
+                         int ioTime )
+{
+    char timeStr[ 20 ];
+    double startTime = accessTimer( clock, LAP_TIMER, timeStr );
+    double ioSpent;
+
+    runNonpreemptiveThread( clock, ioTime );
+
+    // taken off the run time the PCB is charged when it leaves Running
+    ioSpent = accessTimer( clock, LAP_TIMER, timeStr ) - startTime;
+    currBlock->runTime -= ioSpent;
+    currBlock->blockedTime += ioSpent;
+}
+
+//======================================================================
+/**
+* @brief Function waits out the given time on the calling thread
+*
+* @details The function runs the timer for the given time, or moves a
+*   virtual clock on by it.
+*
+* @param[in] clock
+*   A pointer to the SimClock of this simulation
+*
+* @param[in] milliSeconds
+*   An integer representing the milliseconds to wait
+*/
+void waitForTime( SimClock *clock, int milliSeconds )
+{
+    if( clock->virtualTime == True )
+    {
+        advanceClock( clock, milliSeconds );
+        return;
+    }
+    runTimer( ( void * )( &milliSeconds ) );
+}
+
+//======================================================================
+/**
+* @brief Function creates a thread id, attributes, and creates a thread
+*	and detachs it from the main program
+*
+* @details Function charges the PCB for the I/O and notes when it will
+*	end, then posts the interrupt for that time. The I/O is charged as
+*	it starts, so a Blocked PCB never holds an I/O half accounted for.
+*
+* @param[in] container
+* A pointer to a ThreadContainer struct holding all pointers to shared data
+*/
+void runPreemptiveThread( ThreadContainer *container )
+{
+	ProcessControlBlock *pcb = container->currBlock;
+	char timeStr[ 20 ];
+
+	pcb->processTime -= container->waitTime;
+	if( container->clock->virtualTime == True )
+	{
+		pcb->ioDueTime = clockTimeAfter( container->clock,
+										 container->waitTime );
+	}
+	else
+	{
+		pcb->ioDueTime = accessTimer( container->clock, LAP_TIMER, timeStr )
+						 + container->waitTime / 1000.0;
+	}
 
-    return;
+	postIOInterrupt( container );
 }
 
 //======================================================================
 /**
-* @brief Function creates a thread id, attributes, and creates a thread
-*	and detachs it from the main program
+* @brief Function posts the interrupt for the end of a Blocked PCB's I/O
 *
-* @details Function initializes thread data, then creates a thread that
-*	will run the runConcurrentThread method, after detaching from main
-*	so that main doesn't wait for it to rejoin
+* @details Function creates a thread that will run the
+*	runConcurrentThread method, detached so that main doesn't wait for it
+*	to rejoin. On a virtual clock no thread is needed, the interrupt is
+*	posted for the PCB's I/O due time.
 *
-* @param[in] threadTime
-*   An integer representing the milliseconds to run the thread for.
+* @param[in] container
+* A pointer to a ThreadContainer struct holding all pointers to shared
+*	data, its wait time is what is left of the I/O
 */
-void runPreemptiveThread( ThreadContainer *container )
+void postIOInterrupt( ThreadContainer *container )
 {
 	pthread_t tid;
 	pthread_attr_t attr;
+
+	if( container->clock->virtualTime == True )
+	{
+		container->interrupt->dueTime = container->currBlock->ioDueTime;
+		enqueueInt( container->intQueue, container->interrupt );
+		poolFree( &containerPool, container );
+		return;
+	}
+
 	pthread_attr_init( &attr );
 
 	pthread_create( &tid, &attr, runConcurrentThread, container );
@@ -574,9 +1248,12 @@ void runPreemptiveThread( ThreadContainer *container )
 
 //======================================================================
 /**
-* @brief Function
+* @brief Function waits out an I/O in a child process, then posts its
+*	interrupt
 *
-* @details
+* @details The container and its interrupt were made by the CPU that
+*	started the I/O. The container goes straight back to its pool, so
+*	this thread makes no pool caches of its own to flush on exit.
 *
 * @param[in] container
 * A pointer to a ThreadContainer struct holding all pointers to shared data
@@ -585,78 +1262,32 @@ void runPreemptiveThread( ThreadContainer *container )
 void *runConcurrentThread( void *container )
 {
 	ThreadContainer *threadContainer = ( ThreadContainer * )( container );
+	InterruptQueue *intQueue = threadContainer->intQueue;
+	Interrupt *interrupt = threadContainer->interrupt;
+	int waitTime = threadContainer->waitTime;
 
 	pid_t pid;
+
+	// keyed on when the I/O was due, not on when this thread got here
+	interrupt->dueTime = threadContainer->currBlock->ioDueTime;
+	poolFreeShared( &containerPool, threadContainer );
+
 	pid = fork();
 
 	if( pid == 0 )
 	{
-		int *waitTime = &threadContainer->waitTime;
-		runTimer( ( void * )( waitTime ) );
-		exit( 0 );
+		runTimer( ( void * )( &waitTime ) );
+		_exit( 0 );
 	}
 	else
 	{
 		waitpid( pid, NULL, 0 );
 
-		pthread_mutex_lock( &mutex );
-
-		threadContainer->currBlock->processTime -= threadContainer->waitTime;
-
-		enqueueInt( threadContainer->intQueue,
-					createInterrupt( threadContainer->currBlock ) );
-
-		threadContainer->currBlock = NULL;
-		threadContainer->intQueue = NULL;
-		free( threadContainer );
-
-		pthread_mutex_unlock( &mutex );
+		enqueueInt( intQueue, interrupt );
 	}
 	pthread_exit( 0 );
 }
 
-//======================================================================
-/**
-* @brief Function finds the ProcessControlBlock with the shortest
-*   processing time
-*
-* @details Function iterates over process list, and finds the PCB
-*   with the shortest processing time and returns a pointer to that
-*   block. If all PCBs are in EXIT state, NULL returned.
-*
-* @param[in] procList
-*   A pointer to a list holding process control blocks
-*/
-ProcessControlBlock *findShortestJob( ProcessList *procList )
-{
-    ProcessControlBlock *currBlock = procListFirst( procList );
-    ProcessControlBlock *shortestJob = procListFirst( procList );
-
-    while( shortestJob->state == EXIT || shortestJob->state == BLOCKED )
-    {
-        shortestJob = shortestJob->next;
-        if( shortestJob == NULL )
-        {
-            return NULL;
-        }
-    }
-
-    while( currBlock != NULL )
-    {
-        if( currBlock->state != EXIT )
-        {
-            if( currBlock->processTime < shortestJob->processTime &&
-			 	currBlock->state == READY )
-            {
-                shortestJob = currBlock;
-            }
-        }
-        currBlock = currBlock->next;
-    }
-
-    return shortestJob;
-}
-
 //======================================================================
 /**
 * @brief Function processes opCodes, logs output for each one, iterates
@@ -688,6 +1319,8 @@ void processOpCodesNonpreemptive( MetadataNode *currOp, Config *configData,
                     LogList *logList, ProcessControlBlock *currBlock,
                     char *logStr, MMUList *mmu )
 {
+    int swapTime;
+
     while( stringCompare( currOp->operation, "end" ) != 0 )
     {
         if( currOp->command == 'A' )
@@ -701,7 +1334,8 @@ void processOpCodesNonpreemptive( MetadataNode *currOp, Config *configData,
                       "Process %d, run operation start", currBlock->pid );
             logAction( logStr, configData, logList );
 
-            runNonpreemptiveThread( configData->pCycleTime * currOp->value );
+            runNonpreemptiveThread( &logList->clock,
+                                    configData->pCycleTime * currOp->value );
 
             snprintf( logStr, STD_LOG_STR,
                       "Process %d, run operation end", currBlock->pid );
@@ -714,7 +1348,8 @@ void processOpCodesNonpreemptive( MetadataNode *currOp, Config *configData,
                       currBlock->pid, currOp->operation );
             logAction( logStr, configData, logList );
 
-            runNonpreemptiveThread( configData->ioCycleTime * currOp->value );
+            runNonpreemptiveIO( currBlock, &logList->clock,
+                                configData->ioCycleTime * currOp->value );
 
             snprintf( logStr, STD_LOG_STR,
                       "Process %d, %s input end",
@@ -728,7 +1363,8 @@ void processOpCodesNonpreemptive( MetadataNode *currOp, Config *configData,
                       currBlock->pid, currOp->operation );
             logAction( logStr, configData, logList );
 
-            runNonpreemptiveThread( configData->ioCycleTime * currOp->value );
+            runNonpreemptiveIO( currBlock, &logList->clock,
+                                configData->ioCycleTime * currOp->value );
 
             snprintf( logStr, STD_LOG_STR,
                       "Process %d, %s output end",
@@ -739,9 +1375,10 @@ void processOpCodesNonpreemptive( MetadataNode *currOp, Config *configData,
         {
             if( stringCompare( currOp->operation, "allocate" ) == 0 )
             {
-                if( allocateMem( currOp->value, mmu, currBlock, configData,
+                if( allocateMem( currOp, mmu, currBlock, configData,
                             logList ) == -1 )
                 {
+                    currBlock->segFaulted = 1;
                     snprintf( logStr, STD_LOG_STR,
                         "OS: Process %d, Segmentation Fault - Process ended",
                         currBlock->pid );
@@ -751,15 +1388,32 @@ void processOpCodesNonpreemptive( MetadataNode *currOp, Config *configData,
             }
             else if( stringCompare( currOp->operation, "access" ) == 0 )
             {
-                if( accessMem( currOp->value, mmu, currBlock, configData,
-                            logList ) == -1 )
+                if( accessMem( currOp, mmu, currBlock, configData,
+                            logList, &swapTime ) == -1 )
                 {
+                    currBlock->segFaulted = 1;
                     snprintf( logStr, STD_LOG_STR,
                         "OS: Process %d, Segmentation Fault - Process ended",
                         currBlock->pid );
                     logAction( logStr, configData, logList );
                     break;
                 }
+
+                if( swapTime > 0 )
+                {
+                    snprintf( logStr, STD_LOG_STR,
+                              "Process %d, hard drive swap start",
+                              currBlock->pid );
+                    logAction( logStr, configData, logList );
+
+                    runNonpreemptiveIO( currBlock, &logList->clock,
+                                        swapTime );
+
+                    snprintf( logStr, STD_LOG_STR,
+                              "Process %d, hard drive swap end",
+                              currBlock->pid );
+                    logAction( logStr, configData, logList );
+                }
             }
         }
 
@@ -797,16 +1451,17 @@ void processOpCodesNonpreemptive( MetadataNode *currOp, Config *configData,
 *@param[in] procList
 *	A pointer to a PCB linked list storing PCB structs
 *
-*@param[in] ready
-*	A pointer to an interrupt queue storing interrupt structs
+*@param[in] sched
+*	A pointer to the Scheduler deciding when a time slice ends
 *
 */
 void processOpCodesPreemptive( Config *configData, LogList *logList,
 					ProcessControlBlock *currBlock, char *logStr, MMUList *mmu,
 				 	InterruptQueue *intQueue, ProcessList *procList,
-					ReadyQueue *ready )
+					Scheduler *sched )
 {
 	MetadataNode *currOp = currBlock->processHead;
+	int swapTime;
 
     while( stringCompare( currOp->operation, "end" ) != 0 )
     {
@@ -823,54 +1478,65 @@ void processOpCodesPreemptive( Config *configData, LogList *logList,
                       "Process %d, run operation start", currBlock->pid );
             logAction( logStr, configData, logList );
 
-			// void pointer argument for runTimer
-			int *cycleTimePtr = &configData->pCycleTime;
+			// cycles already run are counted in the PCB, not the metadata
 			int index = 0;
-			int beginningCycles = currOp->value;
+			int cyclesLeft = currOp->value - currBlock->opCyclesDone;
+			SLICE_ACTION action = SLICE_CONTINUE;
 
-			while( index < currOp->value && index < configData->quantumTime )
+			while( index < cyclesLeft )
 			{
-				// run one cycle, decrement cycle count, decrease process time
-				runTimer( cycleTimePtr );
+				// run one cycle, count it and decrease process time
+				waitForTime( &logList->clock, configData->pCycleTime );
 				currBlock->processTime -= configData->pCycleTime;
+				currBlock->cyclesRun++;
+				currBlock->opCyclesDone++;
+				index++;
+				traceCycle( intQueue->trace );
+				countIntCycle( intQueue );
+
+				// the policy sees every cycle and says when the slice ends
+				if( sched->onTick != NULL )
+				{
+					action = sched->onTick( sched, currBlock, index,
+											cyclesLeft - index );
+				}
 
 				checkForInterrupts( currBlock, intQueue, logStr, configData,
-									logList, ready, procList );
+									logList, procList );
 				if( currBlock->state != RUN )
 				{
-					currOp->value -= index + 1;
 					return;
 				}
 
-				index++;
-				// check for quantum time
-				if( index == configData->quantumTime &&
-					configData->quantumTime < currOp->value )
+				if( action != SLICE_CONTINUE )
 				{
 					snprintf( logStr, STD_LOG_STR,
 		                      "Process %d quantum time out", currBlock->pid );
 		            logAction( logStr, configData, logList );
 
-					currOp->value -= index;
+					if( action == SLICE_YIELD )
+					{
+						setPCBState( procList, currBlock, READY );
+						snprintf( logStr, STD_LOG_STR,
+								  "OS: Process %d set in Ready state",
+								  currBlock->pid );
+						logAction( logStr, configData, logList );
+						return;
+					}
 					break;
 				}
 			}
-			// any completed cycles
-			if( currOp->value == beginningCycles )
-			{
-				currOp->value -= index;
-			}
-
 			// if P(run) is done, move to next opCode
-			if( currOp->value == 0 )
+			if( currBlock->opCyclesDone == currOp->value )
 			{
 				snprintf( logStr, STD_LOG_STR,
 					"Process %d, run operation end", currBlock->pid );
 					logAction( logStr, configData, logList );
 
 				currBlock->processHead = currBlock->processHead->next;
+				currBlock->opCyclesDone = 0;
 				checkForInterrupts( currBlock, intQueue, logStr, configData,
-									logList, ready, procList );
+									logList, procList );
 			}
         }
         else if( currOp->command == 'I' )
@@ -883,23 +1549,13 @@ void processOpCodesPreemptive( Config *configData, LogList *logList,
                       currBlock->pid, currOp->operation );
             logAction( logStr, configData, logList );
 
-			currBlock->state = BLOCKED;
+			setPCBState( procList, currBlock, BLOCKED );
 			snprintf( logStr, STD_LOG_STR,
                       "OS: Process %d set in Blocked state",
                       currBlock->pid );
             logAction( logStr, configData, logList );
 
             runPreemptiveThread( container );
-
-			if( procList != NULL )
-			{
-				if( getNextReady( procList ) == NULL )
-				{
-					snprintf( logStr, STD_LOG_STR,
-		                      "OS: CPU Idle" );
-		            logAction( logStr, configData, logList );
-				}
-			}
 			return;
         }
         else if( currOp->command == 'O' )
@@ -912,32 +1568,23 @@ void processOpCodesPreemptive( Config *configData, LogList *logList,
                       currBlock->pid, currOp->operation );
             logAction( logStr, configData, logList );
 
-			currBlock->state = BLOCKED;
+			setPCBState( procList, currBlock, BLOCKED );
 			snprintf( logStr, STD_LOG_STR,
                       "OS: Process %d set in Blocked state",
                       currBlock->pid );
             logAction( logStr, configData, logList );
 
             runPreemptiveThread( container );
-
-            if( procList != NULL )
-			{
-				if( getNextReady( procList ) == NULL )
-				{
-					snprintf( logStr, STD_LOG_STR,
-		                      "OS: CPU Idle" );
-		            logAction( logStr, configData, logList );
-				}
-			}
 			return;
         }
         else if( currOp->command == 'M' )
         {
             if( stringCompare( currOp->operation, "allocate" ) == 0 )
             {
-                if( allocateMem( currOp->value, mmu, currBlock, configData,
+                if( allocateMem( currOp, mmu, currBlock, configData,
                             logList ) == -1 )
                 {
+                    currBlock->segFaulted = 1;
                     snprintf( logStr, STD_LOG_STR,
                         "OS: Process %d, Segmentation Fault - Process ended",
                         currBlock->pid );
@@ -947,23 +1594,47 @@ void processOpCodesPreemptive( Config *configData, LogList *logList,
             }
             else if( stringCompare( currOp->operation, "access" ) == 0 )
             {
-                if( accessMem( currOp->value, mmu, currBlock, configData,
-                            logList ) == -1 )
+                if( accessMem( currOp, mmu, currBlock, configData,
+                            logList, &swapTime ) == -1 )
                 {
+                    currBlock->segFaulted = 1;
                     snprintf( logStr, STD_LOG_STR,
                         "OS: Process %d, Segmentation Fault - Process ended",
                         currBlock->pid );
                     logAction( logStr, configData, logList );
                     break;
                 }
+
+				// the access waits for its pages blocked, as on other I/O
+				if( swapTime > 0 )
+				{
+					ThreadContainer *container =
+						buildThreadContainer( configData, logList, intQueue,
+											  currBlock, swapTime );
+					snprintf( logStr, STD_LOG_STR,
+							  "Process %d, hard drive swap start",
+							  currBlock->pid );
+					logAction( logStr, configData, logList );
+
+					setPCBState( procList, currBlock, BLOCKED );
+					snprintf( logStr, STD_LOG_STR,
+							  "OS: Process %d set in Blocked state",
+							  currBlock->pid );
+					logAction( logStr, configData, logList );
+
+					// swapping is not in the process's time, so not taken off
+					currBlock->processTime += swapTime;
+					runPreemptiveThread( container );
+					return;
+				}
             }
 
 			currBlock->processHead = currBlock->processHead->next;
 			checkForInterrupts( currBlock, intQueue, logStr, configData,
-								logList, ready, procList );
+								logList, procList );
         }
     }
-	endProcess( mmu, currBlock );
+	endProcess( mmu, procList, currBlock );
 	snprintf( logStr, STD_LOG_STR,
 			  "OS: Process %d set in Exit state", currBlock->pid );
 	logAction( logStr, configData, logList );
@@ -973,12 +1644,13 @@ void processOpCodesPreemptive( Config *configData, LogList *logList,
 /**
 * @brief Function creates allocation with given values, stores in mmu
 *
-* @details Function extracts data from given opCode value, creates an MMU
-*    node, if returned value from createMMUNode is NULL, log failure,
-*    if a value is returned, add the node to mmu, log success
+* @details Function takes the segment, base and offset decoded from the
+*    opCode value when it was parsed, creates an MMU node, if returned
+*    value from createMMUNode is NULL, log failure, if a value is
+*    returned, add the node to mmu, log success
 *
-* @param[in] value
-*   Integer representing MetadataNode operation value
+* @param[in] memOp
+*   A pointer to the M(allocate) MetadataNode
 *
 * @param[in] mmu
 *    A pointer to a memory list
@@ -993,163 +1665,35 @@ void processOpCodesPreemptive( Config *configData, LogList *logList,
 *   A pointer to a logList struct storing the created logs
 *
 */
-int allocateMem( int value, MMUList *mmu, ProcessControlBlock *currBlock,
+int allocateMem( MetadataNode *memOp, MMUList *mmu, ProcessControlBlock *currBlock,
                 Config *configData, LogList *logList )
 {
-    char valStr[20];
-    char segStr[5];
-    char baseStr[5];
-    char offStr[5];
     char logStr[STD_LOG_STR];
+    int sid = memOp->sid;
+    int base = memOp->base;
+    int offset = memOp->offset;
 
-    sprintf( valStr, "%d", value );
-
-    // M opCode value lead with 7 zeros
-    switch( stringLength( valStr ) )
+    // a value that is not SS/BBB/OOO was decoded with sid -1
+    if( sid < 0 )
     {
-        case 1:
-            segStr[0] = '0';
-            segStr[1] = '0';
-            segStr[2] = '\0';
-
-            baseStr[0] = '0';
-            baseStr[1] = '0';
-            baseStr[2] = '0';
-            baseStr[3] = '\0';
-
-            offStr[0] = '0';
-            offStr[1] = '0';
-            offStr[2] = valStr[0];
-            offStr[3] = '\0';
-
-            break;
-        case 2:
-            segStr[0] = '0';
-            segStr[1] = '0';
-            segStr[2] = '\0';
-
-            baseStr[0] = '0';
-            baseStr[1] = '0';
-            baseStr[2] = '0';
-            baseStr[3] = '\0';
-
-            offStr[0] = '0';
-            offStr[1] = valStr[0];
-            offStr[2] = valStr[1];
-            offStr[3] = '\0';
-
-            break;
-        case 3:
-            segStr[0] = '0';
-            segStr[1] = '0';
-            segStr[2] = '\0';
-
-            baseStr[0] = '0';
-            baseStr[1] = '0';
-            baseStr[2] = '0';
-            baseStr[3] = '\0';
-
-            offStr[0] = valStr[0];
-            offStr[1] = valStr[1];
-            offStr[2] = valStr[2];
-            offStr[3] = '\0';
-
-            break;
-        case 4:
-            segStr[0] = '0';
-            segStr[1] = '0';
-            segStr[2] = '\0';
-
-            baseStr[0] = '0';
-            baseStr[1] = '0';
-            baseStr[2] = valStr[0];
-            baseStr[3] = '\0';
-
-            offStr[0] = valStr[1];
-            offStr[1] = valStr[2];
-            offStr[2] = valStr[3];
-            offStr[3] = '\0';
-
-            break;
-        case 5:
-            segStr[0] = '0';
-            segStr[1] = '0';
-            segStr[2] = '\0';
-
-            baseStr[0] = '0';
-            baseStr[1] = valStr[0];
-            baseStr[2] = valStr[1];
-            baseStr[3] = '\0';
-
-            offStr[0] = valStr[2];
-            offStr[1] = valStr[3];
-            offStr[2] = valStr[4];
-            offStr[3] = '\0';
-
-            break;
-        case 6:
-            segStr[0] = '0';
-            segStr[1] = '0';
-            segStr[2] = '\0';
-
-            baseStr[0] = valStr[0];
-            baseStr[1] = valStr[1];
-            baseStr[2] = valStr[2];
-            baseStr[3] = '\0';
-
-            offStr[0] = valStr[3];
-            offStr[1] = valStr[4];
-            offStr[2] = valStr[5];
-            offStr[3] = '\0';
-
-            break;
-        case 7:
-            segStr[0] = '0';
-            segStr[1] = valStr[0];
-            segStr[2] = '\0';
-
-            baseStr[0] = valStr[1];
-            baseStr[1] = valStr[2];
-            baseStr[2] = valStr[3];
-            baseStr[3] = '\0';
-
-            offStr[0] = valStr[4];
-            offStr[1] = valStr[5];
-            offStr[2] = valStr[6];
-            offStr[3] = '\0';
-
-            break;
-        case 8:
-            segStr[0] = valStr[0];
-            segStr[1] = valStr[1];
-            segStr[2] = '\0';
-
-            baseStr[0] = valStr[2];
-            baseStr[1] = valStr[3];
-            baseStr[2] = valStr[4];
-            baseStr[3] = '\0';
-
-            offStr[0] = valStr[5];
-            offStr[1] = valStr[6];
-            offStr[2] = valStr[7];
-            offStr[3] = '\0';
-
-            break;
-        default:
-            return -1;
+        return -1;
     }
 
-    int sid = stringToInt( segStr );
-    int base = stringToInt( baseStr );
-    int offset = stringToInt( offStr );
-
     snprintf( logStr, STD_LOG_STR,
-              "Process %d, MMU Allocation: %s/%s/%s",
-              currBlock->pid, segStr, baseStr, offStr );
+              "Process %d, MMU Allocation: %02d/%03d/%03d",
+              currBlock->pid, sid, base, offset );
     logAction( logStr, configData, logList );
 
+    pthread_mutex_lock( &mmu->lock );
     MMUNode *node = createMMUNode( currBlock->pid, sid, base, offset,
                                     configData, mmu );
+    if( node != NULL )
+    {
+        addMMUNode( mmu, node );
+        chainMMUNode( &currBlock->firstAlloc, node );
+    }
+    pthread_mutex_unlock( &mmu->lock );
+
     if( node == NULL )
     {
         snprintf( logStr, STD_LOG_STR, "Process %d, MMU Allocation: Failed",
@@ -1158,7 +1702,6 @@ int allocateMem( int value, MMUList *mmu, ProcessControlBlock *currBlock,
         return -1;
     }
 
-    addMMUNode( mmu, node );
     snprintf( logStr, STD_LOG_STR, "Process %d, MMU Allocation: Successful",
               currBlock->pid );
     logAction( logStr, configData, logList );
@@ -1171,12 +1714,18 @@ int allocateMem( int value, MMUList *mmu, ProcessControlBlock *currBlock,
 * @brief Function finds alloc with given SID and PID, and attempts to
 *    access memory in that, returns result
 *
-* @details Function extracts values from access operation, iterates over
-*    mmu list looking for alloc with same SID and PID. If found, attempts
-*    access and returns log. If alloc not found, returns failure.
+* @details Function takes the values decoded from the access operation,
+*    looks up the alloc with same SID and PID in the mmu's sid table. If
+*    found, attempts access and returns log. If alloc not found, returns
+*    failure. The access is moved to where the alloc was placed, which
+*    is its base unless the buddy allocator placed it. With paging on,
+*    every page the placed access touches is then translated, and the
+*    page faults are charged before it succeeds.
+*    Pages swapped in or out are hard drive I/O, left to the caller to
+*    block the process for.
 *
-* @param[in] value
-*   Integer representing MetadataNode operation value
+* @param[in] memOp
+*   A pointer to the M(access) MetadataNode
 *
 * @param[in] mmu
 *    A pointer to a memory list
@@ -1190,189 +1739,69 @@ int allocateMem( int value, MMUList *mmu, ProcessControlBlock *currBlock,
 * @param[in] logList
 *   A pointer to a logList struct storing the created logs
 *
+* @param[out] swapTime
+*   Set to the milliseconds of swap I/O the access needs, 0 if none
+*
 */
-int accessMem( int value, MMUList *mmu, ProcessControlBlock *currBlock,
-                Config *configData, LogList *logList )
+int accessMem( MetadataNode *memOp, MMUList *mmu, ProcessControlBlock *currBlock,
+                Config *configData, LogList *logList, int *swapTime )
 {
-    char valStr[20];
-    char segStr[5];
-    char baseStr[5];
-    char offStr[5];
     char logStr[STD_LOG_STR];
+    int sid = memOp->sid;
+    int base = memOp->base;
+    int offset = memOp->offset;
 
-    sprintf( valStr, "%d", value );
-
-    switch( stringLength( valStr ) )
+    *swapTime = 0;
+    // a value that is not SS/BBB/OOO was decoded with sid -1
+    if( sid < 0 )
     {
-        case 1:
-            segStr[0] = '0';
-            segStr[1] = '0';
-            segStr[2] = '\0';
-
-            baseStr[0] = '0';
-            baseStr[1] = '0';
-            baseStr[2] = '0';
-            baseStr[3] = '\0';
-
-            offStr[0] = '0';
-            offStr[1] = '0';
-            offStr[2] = valStr[0];
-            offStr[3] = '\0';
-
-            break;
-        case 2:
-            segStr[0] = '0';
-            segStr[1] = '0';
-            segStr[2] = '\0';
-
-            baseStr[0] = '0';
-            baseStr[1] = '0';
-            baseStr[2] = '0';
-            baseStr[3] = '\0';
-
-            offStr[0] = '0';
-            offStr[1] = valStr[0];
-            offStr[2] = valStr[1];
-            offStr[3] = '\0';
-
-            break;
-        case 3:
-            segStr[0] = '0';
-            segStr[1] = '0';
-            segStr[2] = '\0';
-
-            baseStr[0] = '0';
-            baseStr[1] = '0';
-            baseStr[2] = '0';
-            baseStr[3] = '\0';
-
-            offStr[0] = valStr[0];
-            offStr[1] = valStr[1];
-            offStr[2] = valStr[2];
-            offStr[3] = '\0';
-
-            break;
-        case 4:
-            segStr[0] = '0';
-            segStr[1] = '0';
-            segStr[2] = '\0';
-
-            baseStr[0] = '0';
-            baseStr[1] = '0';
-            baseStr[2] = valStr[0];
-            baseStr[3] = '\0';
-
-            offStr[0] = valStr[1];
-            offStr[1] = valStr[2];
-            offStr[2] = valStr[3];
-            offStr[3] = '\0';
-
-            break;
-        case 5:
-            segStr[0] = '0';
-            segStr[1] = '0';
-            segStr[2] = '\0';
-
-            baseStr[0] = '0';
-            baseStr[1] = valStr[0];
-            baseStr[2] = valStr[1];
-            baseStr[3] = '\0';
-
-            offStr[0] = valStr[2];
-            offStr[1] = valStr[3];
-            offStr[2] = valStr[4];
-            offStr[3] = '\0';
-
-            break;
-        case 6:
-            segStr[0] = '0';
-            segStr[1] = '0';
-            segStr[2] = '\0';
-
-            baseStr[0] = valStr[0];
-            baseStr[1] = valStr[1];
-            baseStr[2] = valStr[2];
-            baseStr[3] = '\0';
-
-            offStr[0] = valStr[3];
-            offStr[1] = valStr[4];
-            offStr[2] = valStr[5];
-            offStr[3] = '\0';
-
-            break;
-        case 7:
-            segStr[0] = '0';
-            segStr[1] = valStr[0];
-            segStr[2] = '\0';
-
-            baseStr[0] = valStr[1];
-            baseStr[1] = valStr[2];
-            baseStr[2] = valStr[3];
-            baseStr[3] = '\0';
-
-            offStr[0] = valStr[4];
-            offStr[1] = valStr[5];
-            offStr[2] = valStr[6];
-            offStr[3] = '\0';
-
-            break;
-        case 8:
-            segStr[0] = valStr[0];
-            segStr[1] = valStr[1];
-            segStr[2] = '\0';
-
-            baseStr[0] = valStr[2];
-            baseStr[1] = valStr[3];
-            baseStr[2] = valStr[4];
-            baseStr[3] = '\0';
-
-            offStr[0] = valStr[5];
-            offStr[1] = valStr[6];
-            offStr[2] = valStr[7];
-            offStr[3] = '\0';
-
-            break;
-        default:
-            return -1;
+        return -1;
     }
 
-    int sid = stringToInt( segStr );
-    int base = stringToInt( baseStr );
-    int offset = stringToInt( offStr );
-
     snprintf( logStr, STD_LOG_STR,
-              "Process %d, MMU Access: %s/%s/%s",
-              currBlock->pid, segStr, baseStr, offStr );
+              "Process %d, MMU Access: %02d/%03d/%03d",
+              currBlock->pid, sid, base, offset );
     logAction( logStr, configData, logList );
 
-    MMUNode *currNode = MMUListFirst( mmu );
-    while( currNode != NULL )
+    int result = -1;
+    int faults = 0;
+    int swaps = 0;
+    int placedBase;
+
+    pthread_mutex_lock( &mmu->lock );
+    MMUNode *currNode = MMUFind( mmu, currBlock->pid, sid );
+    if( currNode != NULL && base >= currNode->base &&
+        ( base + offset ) <= ( currNode->base + currNode->offset ) )
     {
-        if( currNode->sid != sid || currBlock->pid != currNode->pid )
-        {
-            currNode = currNode->next;
-        }
-        else if( currNode->sid == sid && currBlock->pid == currNode->pid )
+        placedBase = currNode->placed + ( base - currNode->base );
+        result = 0;
+        if( mmu->paging != NULL )
         {
-            if( base >= currNode->base &&
-            ( base + offset ) <= ( currNode->base + currNode->offset ) )
-            {
-                snprintf( logStr, STD_LOG_STR,
-                          "Process %d, MMU Access: Successful",
-                          currBlock->pid );
-                logAction( logStr, configData, logList );
-                return 0;
-            }
-            else
-            {
-                snprintf( logStr, STD_LOG_STR,
-                          "Process %d, MMU Access: Failed",
-                          currBlock->pid );
-                logAction( logStr, configData, logList );
-                return -1;
-            }
+            result = translateAccess( mmu->paging, currBlock, placedBase,
+                                      offset, &faults, &swaps );
         }
     }
+    pthread_mutex_unlock( &mmu->lock );
+
+    if( faults > 0 )
+    {
+        snprintf( logStr, STD_LOG_STR,
+                  "Process %d, MMU Page Faults: %d", currBlock->pid, faults );
+        logAction( logStr, configData, logList );
+
+        waitForTime( &logList->clock, configData->pCycleTime
+                     * configData->pageFaultCycles * faults );
+    }
+    *swapTime = configData->ioCycleTime * configData->swapCycles * swaps;
+
+    if( result == 0 )
+    {
+        snprintf( logStr, STD_LOG_STR,
+                  "Process %d, MMU Access: Successful",
+                  currBlock->pid );
+        logAction( logStr, configData, logList );
+        return 0;
+    }
 
     snprintf( logStr, STD_LOG_STR,
               "Process %d, MMU Access: Failed",
@@ -1383,90 +1812,100 @@ int accessMem( int value, MMUList *mmu, ProcessControlBlock *currBlock,
 
 //======================================================================
 /**
-* @brief Function sets process to EXIT, and deallocates all memory nodes
-*    that contain PID same as the exiting process
+* @brief Function translates every page an access touches
 *
-* @details Function sets process to EXIT, then iterates through mmu list
-*    looking for allocs that contain PID equal to the process PID, and
-*    removes those alloc nodes from mmu list
+* @details The access covers offset KB from base, an access of no length
+*    still touching the page base is in. Each page goes through the TLB,
+*    and the page table on a miss.
 *
-* @param[in] mmu
-*    A pointer to a memory list
+* @param[in] paging
+*    A pointer to the paging unit
 *
 * @param[in] currBlock
-*    A pointer to a ProcessControlBlock
+*    A pointer to the ProcessControlBlock making the access
+*
+* @param[in] base
+*    The first KB accessed
+*
+* @param[in] offset
+*    The number of KB accessed
+*
+* @param[out] faults
+*    Set to the number of pages that had to be given a frame
 *
+* @param[out] swaps
+*    Set to the number of pages written to or read from the swap file
+*
+* @return 0 if every page is in a frame, -1 if one faulted with no frame
+*    free or is past the end of memory, as a buddy allocation's base can be
 */
-void endProcess( MMUList *mmu, ProcessControlBlock *currBlock )
+int translateAccess( Paging *paging, ProcessControlBlock *currBlock,
+                     int base, int offset, int *faults, int *swaps )
 {
-    currBlock->state = EXIT;
-
-    MMUNode *alloc = MMUListFirst( mmu );
-
-    while( alloc != NULL )
+    int page = base / paging->pageSize;
+    int lastPage = ( offset > 0 ? base + offset - 1 : base )
+                   / paging->pageSize;
+    int faulted;
+
+    *faults = 0;
+    *swaps = 0;
+    if( lastPage >= paging->numPages )
     {
-        if( alloc->pid == currBlock->pid )
-        {
-            alloc = removeAlloc( mmu, alloc );
-        }
-        else
+        return -1;
+    }
+    for( ; page <= lastPage; page++ )
+    {
+        faulted = 0;
+        if( translatePage( paging, currBlock->pid, &currBlock->pageTable,
+                           page, &faulted, swaps ) == NO_FRAME )
         {
-            alloc = alloc->next;
+            return -1;
         }
+        *faults += faulted;
     }
+    return 0;
 }
 
 //======================================================================
 /**
-* @brief Function deallocates memory reserved by a process, returns a pointer
-*    to the next allocation
+* @brief Function sets process to EXIT, and deallocates all memory nodes
+*    that contain PID same as the exiting process
 *
-* @details Function searches the mmu list for a given allocation, removes
-*    the alloc node with matching PID and SID, and returns pointer to the
-*    next node in mmu list. Returns NULL if the allocation does not exist
+* @details Function sets process to EXIT, then frees the allocs in the
+*    process's own chain, so no other process's allocs are looked at, and
+*    with paging on hands its frames back
 *
 * @param[in] mmu
 *    A pointer to a memory list
 *
-* @param[in] alloc
-*    A pointer to a memory list node
+* @param[in] procList
+*    A pointer to the process list holding the PCB
+*
+* @param[in] currBlock
+*    A pointer to a ProcessControlBlock
 *
 */
-MMUNode *removeAlloc( MMUList *mmu, MMUNode *alloc )
+void endProcess( MMUList *mmu, ProcessList *procList,
+                 ProcessControlBlock *currBlock )
 {
-    MMUNode *currAlloc = MMUListFirst( mmu );
-
-    if( currAlloc->pid == alloc->pid && currAlloc->sid == alloc->sid )
-    {
-        mmu->first = alloc->next;
-
-        free( alloc );
-        mmu->count--;
-        return mmu->first;
-    }
+    setPCBState( procList, currBlock, EXIT );
 
-    while( currAlloc->next != NULL )
+    pthread_mutex_lock( &mmu->lock );
+    freeMMUChain( mmu, &currBlock->firstAlloc );
+    if( mmu->paging != NULL )
     {
-        if( currAlloc->next->pid == alloc->pid &&
-            currAlloc->next->sid == alloc->sid )
-        {
-            currAlloc->next = alloc->next;
-
-            free( alloc );
-            mmu->count--;
-            return currAlloc->next;
-        }
-        currAlloc = currAlloc->next;
+        freePageTable( mmu->paging, currBlock->pid, &currBlock->pageTable );
     }
-    return NULL;
+    pthread_mutex_unlock( &mmu->lock );
 }
 
 //======================================================================
 /**
 * @brief Function returns whether list contains any process not in Exit
 *
-* @details Function iterates over process list, if any pcb not in Exit
-* state, then return 0, if all in Exit, return 1
+* @details Function compares the number of PCBs in Exit against the size
+* of the list, if any pcb not in Exit state, then return 0, if all in
+* Exit, return 1
 *
 * @param[in] procList
 * A linked list of process control blocks
@@ -1477,97 +1916,96 @@ MMUNode *removeAlloc( MMUList *mmu, MMUNode *alloc )
 */
 int listEmpty( ProcessList *procList )
 {
-    ProcessControlBlock *currBlock = procListFirst( procList );
-
-	while( currBlock != NULL )
-	{
-		if( currBlock->state != EXIT )
-		{
-			return 0;
-		}
-		currBlock = currBlock->next;
-	}
-	return 1;
+	return procStateCount( procList, EXIT ) == procListCount( procList );
 }
 
 //======================================================================
 /**
 * @brief Function returns whether the queue contains any Ready processes
 *
-* @details Function iterates through the queue until finding a processes
-* in the Ready state
+* @details PCBs leave the queue as soon as they leave Ready, so the queue
+* count is the number of Ready processes in it
 *
 * @param[in] ready
 * A queue structure holding nodes that are Ready Process Control Blocks
 *
 * @param[out] int
-* returns 0 if there is a process not in Exit, ie in Blocked or Ready, or Run
+* returns 0 if there is a process in the queue, 1 if it is empty
 *
 */
 int queueEmpty( ReadyQueue *ready )
 {
-    ProcessControlBlock *currBlock = ready->first;
-
-	while( currBlock != NULL )
-	{
-		if( currBlock->state != EXIT )
-		{
-			return 0;
-		}
-		currBlock = currBlock->next;
-	}
-	return 1;
+	return ready->count == 0;
 }
 
 //======================================================================
 /**
-* @brief Function returns the PCB will the smallest PID that is in Ready
+* @brief Function delivers the interrupts due at this check as one batch
 *
-* @details Function iterates through the list of processes, returns the
-* first one it finds in Readyto ensure it has the smallest PID possible
+* @details Unless coalescing holds them for the running process, every
+*   interrupt due is taken off the queue in one pass, then the batch is
+*   handled: the running process, if any, is set Ready, and each process
+*   whose I/O ended moves on to its next opCode, Ready or Exit. The size
+*   of each batch is counted for the report at the end of the run.
 *
-* @param[in] procList
-* A linked list of processes
+* @param[in] pcb
+*   A pointer to the running PCB, or NULL if the CPU is idle
 *
-* @param[out] ProcessControlBlock
-* A process that is in Ready state
+* @param[in] intQueue
+*   A pointer to the InterruptQueue
 *
-*/
-ProcessControlBlock *getNextReady( ProcessList *procList )
-{
-    ProcessControlBlock *currBlock = procListFirst( procList );
-
-	while( currBlock != NULL )
-	{
-		if( currBlock->state == READY )
-		{
-			return currBlock;
-		}
-		currBlock = currBlock->next;
-	}
-	return NULL;
-}
-
-//======================================================================
-/**
-* @brief
+* @param[in] logStr
+*   A string buffer for the log messages
 *
-* @details
+* @param[in] configData
+*   A pointer to the Config struct
 *
-* @param[in]
+* @param[in] logList
+*   A pointer to the LogList
 *
-* @param[out]
+* @param[in] procList
+*   A pointer to the ProcessList
 *
 */
 void checkForInterrupts( ProcessControlBlock *pcb, InterruptQueue *intQueue,
  						char *logStr, Config *configData, LogList *logList,
-						ReadyQueue *ready, ProcessList *procList )
+						ProcessList *procList )
 {
 	Interrupt *interrupt = NULL;
+	Interrupt *batch = NULL;
+	Interrupt **batchEnd = &batch;
+	char timeStr[ 20 ];
+	double currTime = accessTimer( &logList->clock, LAP_TIMER, timeStr );
+	int idle = pcb == NULL;
+	int batchSize = 0;
+
+	traceCheck( intQueue->trace, idle );
+
+	if( !idle && holdInterrupts( intQueue, currTime ) )
+	{
+		return;
+	}
+
+	while( ( interrupt = takeNextInterrupt( intQueue, currTime, idle,
+										logStr, configData, logList ) ) != NULL )
+	{
+		idle = 0;
+		traceRecord( intQueue->trace, interrupt->pcb->pid );
+		interrupt->next = NULL;
+		*batchEnd = interrupt;
+		batchEnd = &interrupt->next;
+		batchSize++;
+	}
+
+	if( batchSize > 0 )
+	{
+		recordIntBatch( intQueue, batchSize );
+	}
 
-	while( intQueue->count != 0 )
+	while( batch != NULL )
 	{
-		interrupt = dequeueInt( intQueue );
+		interrupt = batch;
+		batch = batch->next;
 
 		snprintf( logStr, STD_LOG_STR,
 				  "OS: Interrupt, Process %d", interrupt->pcb->pid );
@@ -1576,11 +2014,7 @@ void checkForInterrupts( ProcessControlBlock *pcb, InterruptQueue *intQueue,
 		if( pcb != NULL )
 		{
 
-			pcb->state = READY;
-			if( ready != NULL )
-			{
-				enqueuePCB( ready, pcb );
-			}
+			setPCBState( procList, pcb, READY );
 			snprintf( logStr, STD_LOG_STR,
 	                  "OS: Process %d set in Ready state", pcb->pid );
 	        logAction( logStr, configData, logList );
@@ -1602,39 +2036,109 @@ void checkForInterrupts( ProcessControlBlock *pcb, InterruptQueue *intQueue,
 				interrupt->pcb->processHead->operation );
 			logAction( logStr, configData, logList );
 		}
+		else if( interrupt->pcb->processHead->command == 'M' )
+		{
+			snprintf( logStr, STD_LOG_STR,
+				"Process %d, hard drive swap end", interrupt->pcb->pid );
+			logAction( logStr, configData, logList );
+		}
 
 		interrupt->pcb->processHead = interrupt->pcb->processHead->next;
 
 		if( interrupt->pcb->processTime == 0 )
 		{
-			interrupt->pcb->state = EXIT;
+			if( intQueue->mmu != NULL )
+			{
+				endProcess( intQueue->mmu, procList, interrupt->pcb );
+			}
+			else
+			{
+				setPCBState( procList, interrupt->pcb, EXIT );
+			}
 			snprintf( logStr, STD_LOG_STR,
 					  "OS: Process %d set in Exit state",
 					  interrupt->pcb->pid );
 			logAction( logStr, configData, logList );
 
-			free( interrupt );
-			interrupt = NULL;
-			return;
+			freeInterrupt( interrupt );
+			continue;
 		}
 
-		interrupt->pcb->state = READY;
-
-		if( ready != NULL )
-		{
-			enqueuePCB( ready, interrupt->pcb );
-		}
+		setPCBState( procList, interrupt->pcb, READY );
 		snprintf( logStr, STD_LOG_STR,
 				  "OS: Process %d set in Ready state",
 				  interrupt->pcb->pid );
 		logAction( logStr, configData, logList );
 
-		free( interrupt );
-		interrupt = NULL;
+		freeInterrupt( interrupt );
 	}
 	return;
 }
 
+//======================================================================
+/**
+* @brief Function takes the next interrupt to deliver at this check
+*
+* @details Without a replay, that is the first interrupt due by the
+*   current time. A replay takes the interrupt the trace delivered here
+*   instead, whether or not it is due. If the run no longer matches the
+*   trace, either because the recorded interrupt is not queued or because
+*   the idle CPU would wait for an interrupt the trace has not got, the
+*   replay is abandoned and interrupts are delivered by time from then on.
+*
+* @param[in] intQueue
+*   A pointer to the InterruptQueue
+*
+* @param[in] currTime
+*   The current time in seconds
+*
+* @param[in] idle
+*   Nonzero if the CPU is idle and nothing has been delivered at this check
+*
+* @param[in] logStr
+*   A string buffer for the log message
+*
+* @param[in] configData
+*   A pointer to the Config struct
+*
+* @param[in] logList
+*   A pointer to the LogList
+*
+* @return the interrupt to deliver, or NULL if there is none
+*/
+Interrupt *takeNextInterrupt( InterruptQueue *intQueue, double currTime,
+							  int idle, char *logStr, Config *configData,
+							  LogList *logList )
+{
+	IntTrace *trace = intQueue->trace;
+	Interrupt *interrupt;
+	int pid;
+
+	if( trace == NULL || !trace->replaying )
+	{
+		return dequeueInt( intQueue, currTime );
+	}
+
+	pid = traceReplayPid( trace );
+	if( pid == -1 && !idle )
+	{
+		return NULL;
+	}
+
+	interrupt = pid == -1 ? NULL : takeIntForPid( intQueue, pid );
+	if( interrupt != NULL )
+	{
+		return interrupt;
+	}
+
+	trace->replaying = 0;
+	snprintf( logStr, STD_LOG_STR,
+			  "OS: Interrupt replay diverged, delivering by time" );
+	logAction( logStr, configData, logList );
+
+	return dequeueInt( intQueue, currTime );
+}
+
 //======================================================================
 /**
 * @brief Function creates container for shared memory for threads
@@ -1659,17 +2163,21 @@ void checkForInterrupts( ProcessControlBlock *pcb, InterruptQueue *intQueue,
 * A pointer to the struct containing configuration data
 *
 * @param[out] threadContainer
-* A struct containing pointers to each of the parameters given
+* A struct containing pointers to each of the parameters given and to
+* the interrupt that will end the I/O
 *
 */
 ThreadContainer *buildThreadContainer( Config *configData, LogList *logList,
 								InterruptQueue *intQueue,
 								ProcessControlBlock *currBlock, int waitTime )
 {
-	ThreadContainer *container = malloc( sizeof( ThreadContainer ) );
+	ThreadContainer *container = poolAlloc( &containerPool );
 	container->intQueue = intQueue;
 	container->currBlock = currBlock;
 	container->waitTime = waitTime;
+	container->clock = &logList->clock;
+	// due time is filled in once the I/O is under way
+	container->interrupt = createInterrupt( currBlock, 0 );
 
 	return container;
 }
@@ -1703,7 +2211,7 @@ void printPCBStatus( ReadyQueue *ready )
 			printf("Process: %d\n", currBlock->pid);
 			printf("State:   %d\n", currBlock->state);
 			printf("Time:    %d\n\n", currBlock->processTime);
-			currBlock = currBlock->next;
+			currBlock = currBlock->nextInQueue;
 		}
 		printf("---------------------\n\n");
 	}
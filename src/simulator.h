@@ -33,8 +33,11 @@ Secret Number: 764819
 #include "configParser.h"
 #include "mmuList.h"
 #include "interruptQueue.h"
-#include "readyQueue.h"
+#include "scheduler.h"
+#include "procMetrics.h"
+#include "workDeque.h"
 #include "simtimer.h"
+#include "checkpoint.h"
 
 //
 // Data Structure Definitions (structs, enums, etc.)////////////////
@@ -44,18 +47,66 @@ typedef struct ThreadContainer
 	InterruptQueue *intQueue;
 	ProcessControlBlock *currBlock;
 	int waitTime;
+	SimClock *clock;
+	Interrupt *interrupt;
 } ThreadContainer;
+
+struct MultiCore;
+
+typedef struct CPUCore
+{
+	int coreId;
+	pthread_t tid;
+	WorkDeque deque;
+	double busyTime;
+	int processesRun;
+	int processesStolen;
+	struct MultiCore *system;
+} CPUCore;
+
+typedef struct MultiCore
+{
+	int numCores;
+	CPUCore *cores;
+	Config *configData;
+	ProcessList *procList;
+	LogList *logList;
+	MMUList *mmu;
+} MultiCore;
+
+/*
+  What one run of the simulator reports back to its caller, times are
+  milliseconds from System Start
+*/
+typedef struct SimResult
+{
+	int processes;
+	double makespan;
+	double meanTurnaround;
+	double meanResponse;
+	double cpuUtilization;
+	int segFaults;
+} SimResult;
 //
 // Free Function Prototypes ///////////////////////////////////////
 //
 //==========================================================================
 
-void runSimulator( MetadataList *mdList, Config *configData );
+void runSimulator( MetadataList *mdList, Config *configData,
+                   SimResult *result );
+
+//==========================================================================
+
+int resumeSimulator( char *checkpointPath, SimResult *result );
 
 //==========================================================================
 
 void runScheduler( Config *configData, ProcessList *procList, LogList *logList,
-                    MMUList *mmu );
+                    MMUList *mmu, SimResult *result );
+
+//==========================================================================
+
+void checkSwapFile( MMUList *mmu, Config *configData, LogList *logList );
 
 //==========================================================================
 
@@ -68,28 +119,46 @@ void runOSStart( MetadataList *mdList, ProcessList *procList,
 
 //==========================================================================
 
-void runFCFS( Config *configData, ProcessList *procList, LogList *logList,
-                MMUList *mmu );
+void runDispatcher( Scheduler *sched, MMUList *mmu );
+
+//==========================================================================
+
+void reportIntBatches( InterruptQueue *intQueue, Config *configData,
+					   LogList *logList );
+
+//==========================================================================
+
+void reportPaging( Paging *paging, Config *configData, LogList *logList );
+
+//==========================================================================
+
+void reportAllocator( BuddyAllocator *buddy, Config *configData,
+					  LogList *logList );
+
+//==========================================================================
+
+void reportMetrics( Config *configData, ProcessList *procList,
+                    LogList *logList, int cpusUsed, SimResult *result );
+
+//==========================================================================
+
+void runMultiCore( Scheduler *sched, MMUList *mmu );
 
 //==========================================================================
 
-void runSJFN( Config *configData, ProcessList *procList, LogList *logList,
-                MMUList *mmu );
+void *runCPUCore( void *core );
 
 //==========================================================================
 
-void runSRTF( Config *configData, ProcessList *procList, LogList *logList,
-                MMUList *mmu );
+void runCoresVirtual( MultiCore *system );
 
 //==========================================================================
 
-void runFCFSP( Config *configData, ProcessList *procList, LogList *logList,
-                MMUList *mmu );
+int runNextOnCore( CPUCore *cpu );
 
 //==========================================================================
 
-void runRRP( Config *configData, ProcessList *procList, LogList *logList,
-                MMUList *mmu );
+ProcessControlBlock *stealForCore( CPUCore *cpu );
 
 //==========================================================================
 
@@ -97,7 +166,16 @@ void logListToFile( Config *configData, LogList *logList );
 
 //==========================================================================
 
-void runNonpreemptiveThread( int threadTime );
+void runNonpreemptiveThread( SimClock *clock, int threadTime );
+
+//==========================================================================
+
+void runNonpreemptiveIO( ProcessControlBlock *currBlock, SimClock *clock,
+                         int ioTime );
+
+//==========================================================================
+
+void waitForTime( SimClock *clock, int milliSeconds );
 
 //==========================================================================
 
@@ -105,11 +183,17 @@ void runPreemptiveThread( ThreadContainer *container );
 
 //==========================================================================
 
-void *runConcurrentThread( void *container );
+void resumeBlockedIO( InterruptQueue *intQueue, Config *configData,
+					  LogList *logList, ProcessList *procList );
 
 //==========================================================================
 
-ProcessControlBlock *findShortestJob( ProcessList *procList );
+void postIOInterrupt( ThreadContainer *container );
+
+//==========================================================================
+
+void *runConcurrentThread( void *container );
+
 
 //==========================================================================
 
@@ -122,25 +206,28 @@ void processOpCodesNonpreemptive( MetadataNode *currOp, Config *configData,
 void processOpCodesPreemptive( Config *configData, LogList *logList,
 				ProcessControlBlock *currBlock, char *logStr, MMUList *mmu,
 			 	InterruptQueue *intQueue, ProcessList *procList,
-				ReadyQueue *ready );
+				Scheduler *sched );
 
 //==========================================================================
 
-int allocateMem( int value, MMUList *mmu, ProcessControlBlock *currBlock,
+int allocateMem( MetadataNode *memOp, MMUList *mmu, ProcessControlBlock *currBlock,
                 Config *configData, LogList *logList );
 
 //==========================================================================
 
-int accessMem( int value, MMUList *mmu, ProcessControlBlock *currBlock,
-                Config *configData, LogList *logList );
+int accessMem( MetadataNode *memOp, MMUList *mmu, ProcessControlBlock *currBlock,
+                Config *configData, LogList *logList, int *swapTime );
 
 //==========================================================================
 
-void endProcess( MMUList *mmu, ProcessControlBlock *currBlock );
+int translateAccess( Paging *paging, ProcessControlBlock *currBlock,
+                     int base, int offset, int *faults, int *swaps );
 
 //==========================================================================
 
-MMUNode *removeAlloc( MMUList *mmu, MMUNode *alloc );
+void endProcess( MMUList *mmu, ProcessList *procList,
+                 ProcessControlBlock *currBlock );
+
 
 //==========================================================================
 
@@ -150,15 +237,18 @@ int listEmpty( ProcessList *procList );
 
 int queueEmpty( ReadyQueue *ready );
 
-//==========================================================================
-
-ProcessControlBlock *getNextReady( ProcessList *procList );
 
 //==========================================================================
 
 void checkForInterrupts( ProcessControlBlock *pcb, InterruptQueue *intQueue,
  						char *logStr, Config *configData, LogList *logList,
-					 	ReadyQueue *ready, ProcessList *procList );
+					 	ProcessList *procList );
+
+//==========================================================================
+
+Interrupt *takeNextInterrupt( InterruptQueue *intQueue, double currTime,
+							  int idle, char *logStr, Config *configData,
+							  LogList *logList );
 
 //==========================================================================
 
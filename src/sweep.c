@@ -0,0 +1,459 @@
+// PROGRAMMER INFORMATION ////////////////////////////////////////////
+/**
+
+Secret Number: 764819
+
+*/
+// Code Implementation File Information /////////////////////////////
+/**
+* @file sweep.c
+*
+* @brief Implementation file for sweep code
+*
+* @details Implements all functions of the parameter sweep
+*/
+// Program Description/Support /////////////////////////////////////
+/*
+This program takes a configuration file and, for any of its fields, a
+range or list of values, and simulates every combination of them. The
+metadata is parsed once and shared by every point, each point gets its
+own copy of the configuration. Points run on the batch worker pool on a
+virtual clock, so they take no longer than the work of simulating them
+and their times do not depend on how many run at once. Logs are kept in
+memory only. A table of each point's makespan, mean turnaround and
+response time and segmentation fault count is printed, and can also be
+written as CSV.
+*/
+// Header Files ///////////////////////////////////////////////////
+//
+#include "sweep.h"
+//
+// Global Constant Definitions ////////////////////////////////////
+//
+const char SWEEP_FLAG[] = "--sweep";
+const char RESULTS_FLAG[] = "-o";
+const int MAX_SWEEP_POINTS = 100000;
+//
+// Free Function Prototypes ///////////////////////////////////////
+//
+static void setPointConfig( Config *baseConfig, SweepAxis *axes,
+                            int numAxes, int point, Config *configData );
+//
+//==========================================================================
+/**
+* @brief Function runs a configuration over every combination of the
+*   given field values
+*
+* @details The first argument is the configuration file. Every other
+*   argument is a field to sweep, written field=low:high[:step] or
+*   field=value,value,..., or -j with the number of points to run at
+*   once, or -o with a file to write the results to as CSV.
+*
+* @par Algorithm
+*   Function parses the configuration and its metadata once, reads each
+*   field's values and checks every one of them against the field's
+*   constraints before anything runs. It then makes one job per point,
+*   each with its own configuration set to the point's values on a
+*   virtual clock with logging kept in memory, runs them all on the batch
+*   workers and prints the results.
+*
+* @param[in] argc
+* Number of sweep arguments
+*
+* @param[in] argv
+* The sweep arguments, starting at the configuration file
+*
+* @return no error message if the sweep ran, an error code otherwise
+*/
+int runSweep( int argc, char *argv[] )
+{
+    FILE *configFile, *metaFile = NULL, *resultsFile;
+    Config baseConfig, checkConfig;
+    MetadataList *mdList = NULL;
+    SweepAxis *axes = malloc( sizeof( SweepAxis ) * ( argc + 1 ) );
+    BatchRunner batch;
+    BatchJob *job;
+    char *resultsPath = NULL;
+    int numAxes = 0, numWorkers = 1, numPoints = 1;
+    int index, value, status = NO_ERROR_MSG;
+
+    for( index = 1; index < argc && status == NO_ERROR_MSG; index++ )
+    {
+        if( stringCompare( argv[ index ], WORKERS_FLAG ) == 0 &&
+            index + 1 < argc )
+        {
+            numWorkers = stringToInt( argv[ ++index ] );
+            if( numWorkers < 1 || numWorkers > MAX_BATCH_WORKERS )
+            {
+                printf( "===ERR: %s TAKES 1-%d===\n", WORKERS_FLAG,
+                        MAX_BATCH_WORKERS );
+                status = INVALID_DATA;
+            }
+        }
+        else if( stringCompare( argv[ index ], RESULTS_FLAG ) == 0 &&
+                 index + 1 < argc )
+        {
+            resultsPath = argv[ ++index ];
+        }
+        else if( parseSweepAxis( argv[ index ], &axes[ numAxes ] )
+                 == NO_ERROR_MSG )
+        {
+            numPoints *= axes[ numAxes ].numValues;
+            numAxes++;
+            if( numPoints > MAX_SWEEP_POINTS )
+            {
+                printf( "===ERR: SWEEP HAS MORE THAN %d POINTS===\n",
+                        MAX_SWEEP_POINTS );
+                status = INVALID_DATA;
+            }
+        }
+        else
+        {
+            printf( "===ERR: INVALID SWEEP %s===\n", argv[ index ] );
+            status = INVALID_DATA;
+        }
+    }
+
+    configFile = status == NO_ERROR_MSG ? openFile( argv[ 0 ] ) : NULL;
+    if( status == NO_ERROR_MSG && configFile == NULL )
+    {
+        printf( "===ERR: CONFIGURATION FILE NOT FOUND===\n" );
+        status = FILE_NOT_FOUND_ERR;
+    }
+    else if( status == NO_ERROR_MSG &&
+             parseConfig( configFile, &baseConfig ) == INVALID_CONFIG_FILE )
+    {
+        printf( "===ERR: INVALID CONFIGURATION FILE===\n" );
+        status = INVALID_CONFIG_FILE;
+    }
+    if( configFile != NULL )
+    {
+        closeFile( configFile );
+    }
+
+    // a bad value should stop the sweep before any point has run
+    for( index = 0; index < numAxes && status == NO_ERROR_MSG; index++ )
+    {
+        for( value = 0; value < axes[ index ].numValues &&
+                        status == NO_ERROR_MSG; value++ )
+        {
+            checkConfig = baseConfig;
+            status = setConfigField( &checkConfig, axes[ index ].fieldName,
+                                     axes[ index ].values[ value ] );
+            if( status == UNKNOWN_ERR )
+            {
+                printf( "===ERR: UNKNOWN CONFIG FIELD %s===\n",
+                        axes[ index ].fieldName );
+            }
+            else if( status != NO_ERROR_MSG )
+            {
+                printf( "===ERR: INVALID VALUE %s FOR %s===\n",
+                        axes[ index ].values[ value ],
+                        axes[ index ].fieldName );
+            }
+        }
+    }
+
+    metaFile = status == NO_ERROR_MSG ?
+               openFile( baseConfig.metadataFilePath ) : NULL;
+    if( status == NO_ERROR_MSG && metaFile == NULL )
+    {
+        printf( "===ERR: METADATA FILE NOT FOUND===\n" );
+        status = FILE_NOT_FOUND_ERR;
+    }
+
+    if( status == NO_ERROR_MSG )
+    {
+        mdList = mdListCreate();
+        if( parseMetadata( metaFile, mdList ) == INVALID_METADATA_FILE )
+        {
+            printf( "===ERR: INVALID METADATA FILE===\n" );
+            status = INVALID_METADATA_FILE;
+        }
+        closeFile( metaFile );
+
+        if( status == NO_ERROR_MSG )
+        {
+            batch.numJobs = numPoints;
+            batch.jobs = malloc( sizeof( BatchJob ) * numPoints );
+
+            for( index = 0; index < numPoints; index++ )
+            {
+                job = &batch.jobs[ index ];
+                snprintf( job->configPath, sizeof( job->configPath ), "%s",
+                          argv[ 0 ] );
+                job->metadataPath[ 0 ] = NUL;
+                setPointConfig( &baseConfig, axes, numAxes, index,
+                                &job->configData );
+                job->mdList = mdList;
+                job->status = UNKNOWN_ERR;
+            }
+
+            runBatchJobs( &batch, numWorkers );
+            printSweepResults( stdout, 0, axes, numAxes, &batch );
+
+            if( resultsPath != NULL )
+            {
+                resultsFile = writeToFile( resultsPath );
+                if( resultsFile == NULL )
+                {
+                    printf( "===ERR: COULD NOT WRITE %s===\n", resultsPath );
+                }
+                else
+                {
+                    printSweepResults( resultsFile, 1, axes, numAxes,
+                                       &batch );
+                    closeFile( resultsFile );
+                }
+            }
+
+            free( batch.jobs );
+        }
+        mdListDestroy( mdList );
+    }
+
+    for( index = 0; index < numAxes; index++ )
+    {
+        freeSweepAxis( &axes[ index ] );
+    }
+    free( axes );
+
+    return status;
+}
+
+//==========================================================================
+/**
+* @brief Function reads one field to sweep and its values
+*
+* @details The argument is the field name, an equals sign, then either a
+*   range low:high or low:high:step of whole numbers, or a comma
+*   separated list of values as they would be written in a configuration
+*   file. A single value is a list of one.
+*
+* @param[in] arg
+* The argument to read, such as quantumTime=1:10:3 or
+*   scheduleCode=RR-P,MLFQ-P
+*
+* @param[out] axis
+* Receives the field name and its values
+*
+* @return no error message if read, invalid data otherwise
+*/
+int parseSweepAxis( char *arg, SweepAxis *axis )
+{
+    char *valueStr = arg;
+    int nameLength = 0, low, high, step = 1, count, index;
+
+    while( valueStr[ 0 ] != NUL && valueStr[ 0 ] != '=' )
+    {
+        valueStr++;
+        nameLength++;
+    }
+    if( valueStr[ 0 ] != '=' || nameLength == 0 || nameLength >= 50 ||
+        valueStr[ 1 ] == NUL )
+    {
+        return INVALID_DATA;
+    }
+    valueStr++;
+
+    for( index = 0; index < nameLength; index++ )
+    {
+        axis->fieldName[ index ] = arg[ index ];
+    }
+    axis->fieldName[ nameLength ] = NUL;
+    axis->numValues = 0;
+
+    count = sscanf( valueStr, "%d:%d:%d", &low, &high, &step );
+    if( count >= 2 )
+    {
+        if( step < 1 || high < low ||
+            ( high - low ) / step >= MAX_SWEEP_POINTS )
+        {
+            return INVALID_DATA;
+        }
+
+        axis->values = malloc( sizeof( char * ) *
+                               ( ( high - low ) / step + 1 ) );
+        for( index = low; index <= high; index += step )
+        {
+            axis->values[ axis->numValues ] = malloc( STD_STR );
+            snprintf( axis->values[ axis->numValues ], STD_STR, "%d",
+                      index );
+            axis->numValues++;
+        }
+        return NO_ERROR_MSG;
+    }
+
+    count = 1;
+    for( index = 0; valueStr[ index ] != NUL; index++ )
+    {
+        count += valueStr[ index ] == ',';
+    }
+    axis->values = malloc( sizeof( char * ) * count );
+
+    while( axis->numValues < count )
+    {
+        axis->values[ axis->numValues ] = malloc( STD_STR );
+        for( index = 0; valueStr[ index ] != NUL &&
+                        valueStr[ index ] != ','; index++ )
+        {
+            if( index < STD_STR - 1 )
+            {
+                axis->values[ axis->numValues ][ index ] = valueStr[ index ];
+            }
+        }
+        axis->values[ axis->numValues ][ index < STD_STR - 1 ?
+                                         index : STD_STR - 1 ] = NUL;
+        axis->numValues++;
+
+        valueStr += valueStr[ index ] == ',' ? index + 1 : index;
+    }
+    return NO_ERROR_MSG;
+}
+
+//==========================================================================
+/**
+* @brief Function frees the values of a sweep axis
+*
+* @param[in] axis
+* A SweepAxis pointer
+*/
+void freeSweepAxis( SweepAxis *axis )
+{
+    int index;
+
+    for( index = 0; index < axis->numValues; index++ )
+    {
+        free( axis->values[ index ] );
+    }
+    free( axis->values );
+    axis->numValues = 0;
+}
+
+//==========================================================================
+/**
+* @brief Function sets up the configuration for one point of the sweep
+*
+* @details Points are numbered with the last field changing fastest. The
+*   base configuration is copied and each field set to its value for the
+*   point. The point runs on a virtual clock, logs only to memory and
+*   writes no metrics file, since every point shares the base's paths.
+*
+* @param[in] baseConfig
+* The configuration read from the file
+*
+* @param[in] axes
+* The swept fields
+*
+* @param[in] numAxes
+* Number of swept fields
+*
+* @param[in] point
+* Index of the point
+*
+* @param[out] configData
+* Receives the point's configuration
+*/
+static void setPointConfig( Config *baseConfig, SweepAxis *axes,
+                            int numAxes, int point, Config *configData )
+{
+    int index;
+
+    *configData = *baseConfig;
+
+    for( index = numAxes - 1; index >= 0; index-- )
+    {
+        // every value was checked before the sweep started
+        setConfigField( configData, axes[ index ].fieldName,
+                axes[ index ].values[ point % axes[ index ].numValues ] );
+        point /= axes[ index ].numValues;
+    }
+
+    configData->virtualTime = 1;
+    copyString( configData->logTo, ( char * )LOG_TO_NONE );
+    configData->metricsFilePath[ 0 ] = NUL;
+    configData->recordFilePath[ 0 ] = NUL;
+    configData->replayFilePath[ 0 ] = NUL;
+    configData->checkpointInterval = 0;
+}
+
+//==========================================================================
+/**
+* @brief Function prints the result of every point of a sweep
+*
+* @details One row per point, giving the value of each swept field, then
+*   the makespan, mean turnaround and mean response time in milliseconds
+*   and the number of processes ended by a segmentation fault.
+*
+* @param[in] file
+* The file to print to
+*
+* @param[in] csv
+* Nonzero to print comma separated values, zero for a table
+*
+* @param[in] axes
+* The swept fields
+*
+* @param[in] numAxes
+* Number of swept fields
+*
+* @param[in] batch
+* A BatchRunner pointer holding one job per point, every job run
+*/
+void printSweepResults( FILE *file, int csv, SweepAxis *axes, int numAxes,
+                        BatchRunner *batch )
+{
+    SimResult *result;
+    int point, index, valueIndex, divisor;
+
+    if( !csv )
+    {
+        fprintf( file, "Sweep Results\n" );
+        fprintf( file, "====================\n" );
+    }
+
+    fprintf( file, csv ? "point" : "Point" );
+    for( index = 0; index < numAxes; index++ )
+    {
+        fprintf( file, csv ? ",%s" : "  %12s", axes[ index ].fieldName );
+    }
+    fprintf( file, csv ? ",makespan,mean_turnaround,mean_response,"
+                         "seg_faults\n" :
+                         "  Makespan  Turnaround  Response  SegFaults\n" );
+
+    for( point = 0; point < batch->numJobs; point++ )
+    {
+        result = &batch->jobs[ point ].result;
+        fprintf( file, csv ? "%d" : "%5d", point + 1 );
+
+        divisor = 1;
+        for( index = numAxes - 1; index >= 0; index-- )
+        {
+            divisor *= axes[ index ].numValues;
+        }
+        for( index = 0; index < numAxes; index++ )
+        {
+            divisor /= axes[ index ].numValues;
+            valueIndex = point / divisor % axes[ index ].numValues;
+            fprintf( file, csv ? ",%s" : "  %12s",
+                     axes[ index ].values[ valueIndex ] );
+        }
+
+        fprintf( file, csv ? ",%.3f,%.3f,%.3f,%d\n" :
+                             "  %8.1f  %10.1f  %8.1f  %9d\n",
+                 result->makespan, result->meanTurnaround,
+                 result->meanResponse, result->segFaults );
+    }
+
+    if( !csv )
+    {
+        fprintf( file, "====================\n" );
+        fprintf( file, "%d points, times in msec\n", batch->numJobs );
+    }
+}
+
+//==========================================================================
+// Terminating Precompiler Directives ///////////////////////////////
+//
+///// NONE
+//
@@ -0,0 +1,72 @@
+// PROGRAMMER INFORMATION ////////////////////////////////////////////
+/**
+
+Secret Number: 764819
+
+*/
+// Header File Information /////////////////////////////////////
+/**
+* @file sweep.h
+*
+* @brief Header file for sweep code
+*
+* @details Specifies functions, constants, and other information
+* related to running a configuration over ranges of its field values
+*/
+// Precompiler Directives //////////////////////////////////////////
+//
+#ifndef SWEEP_H
+#define SWEEP_H
+//
+// Header Files ///////////////////////////////////////////////////
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include "configParser.h"
+#include "metadataParser.h"
+#include "metadataList.h"
+#include "utilities.h"
+#include "batch.h"
+//
+// Global Constant Definitions ////////////////////////////////////
+//
+extern const char SWEEP_FLAG[];
+extern const char RESULTS_FLAG[];
+extern const int MAX_SWEEP_POINTS;
+//
+// Data Structure Definitions (structs, enums, etc.)////////////////
+//
+/*
+  One swept Config field and every value it takes, written as they would
+  be in a configuration file
+*/
+typedef struct SweepAxis
+{
+    char fieldName[ 50 ];
+    int numValues;
+    char **values;
+} SweepAxis;
+//
+// Free Function Prototypes ///////////////////////////////////////
+//
+//==========================================================================
+
+int runSweep( int argc, char *argv[] );
+
+//==========================================================================
+
+int parseSweepAxis( char *arg, SweepAxis *axis );
+
+//==========================================================================
+
+void freeSweepAxis( SweepAxis *axis );
+
+//==========================================================================
+
+void printSweepResults( FILE *file, int csv, SweepAxis *axes, int numAxes,
+                        BatchRunner *batch );
+
+// Terminating Precompiler Directives ///////////////////////////////
+//
+#endif // SWEEP_H
+//
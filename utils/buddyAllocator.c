@@ -0,0 +1,350 @@
+// PROGRAMMER INFORMATION ////////////////////////////////////////////
+/**
+
+Secret Number: 764819
+
+*/
+// Code Implementation File Information /////////////////////////////
+/**
+* @file buddyAllocator.c
+*
+* @brief Implementation file for buddyAllocator code
+*
+* @details Implements all functions of the buddy allocator
+*/
+// Program Description/Support /////////////////////////////////////
+/*
+With the buddy allocator configured, an allocation gives only its size
+and is placed in the smallest free block of a power of two KB that holds
+it, a larger block being split in halves until one is the right size.
+A freed block is joined with its buddy, the other half of the block it
+was split from, for as long as the buddy is free too. Memory that is not
+a power of two starts as the largest aligned blocks that fit. The
+metadata base of an allocation is then only a name for its start, an
+access being moved from it into the placed block.
+*/
+// Header Files ///////////////////////////////////////////////////
+//
+#include "buddyAllocator.h"
+//
+// Global Constant Definitions ////////////////////////////////////
+//
+// 2^20 KB is the largest memory the config allows
+const int MAX_BUDDY_ORDER = 20;
+//
+// Free Function Prototypes ///////////////////////////////////////
+//
+static void pushFreeBlock( BuddyAllocator *buddy, int start, int order );
+static void unlinkFreeBlock( BuddyAllocator *buddy, int start );
+static void sampleExtFrag( BuddyAllocator *buddy );
+//
+//==========================================================================
+/**
+* @brief Function creates the buddy allocator for a memory of given size
+*
+* @details No allocator is needed if allocations are placed where the
+*   metadata says.
+*
+* @par Algorithm
+* Function starts at KB 0 and repeatedly frees the largest block that
+*   starts there, is aligned to its size and ends inside memory, moving
+*   on past it until all of memory is in free blocks.
+*
+* @param[in] totalMem
+* The size of memory in KB
+*
+* @param[in] configData
+* A pointer to the Config struct naming the allocator
+*
+* @return a pointer to the allocator, or NULL if it is not configured
+*/
+BuddyAllocator *createBuddyAllocator( int totalMem, Config *configData )
+{
+    BuddyAllocator *buddy;
+    int start;
+    int order;
+
+    if( !configData->buddyAllocator )
+    {
+        return NULL;
+    }
+
+    buddy = malloc( sizeof( BuddyAllocator ) );
+    buddy->totalMemory = totalMem;
+    buddy->freeMemory = 0;
+    buddy->maxOrder = 0;
+    buddy->freeHead = malloc( sizeof( int ) * ( MAX_BUDDY_ORDER + 1 ) );
+    for( order = 0; order <= MAX_BUDDY_ORDER; order++ )
+    {
+        buddy->freeHead[ order ] = -1;
+    }
+    buddy->nextFree = malloc( sizeof( int ) * ( totalMem + 1 ) );
+    buddy->prevFree = malloc( sizeof( int ) * ( totalMem + 1 ) );
+    buddy->blockOrder = malloc( sizeof( signed char ) * ( totalMem + 1 ) );
+    buddy->blockFree = calloc( totalMem + 1, sizeof( char ) );
+    for( start = 0; start < totalMem; start++ )
+    {
+        buddy->blockOrder[ start ] = -1;
+    }
+
+    for( start = 0; start < totalMem; start += 1 << order )
+    {
+        order = 0;
+        while( order < MAX_BUDDY_ORDER &&
+               start % ( 2 << order ) == 0 &&
+               start + ( 2 << order ) <= totalMem )
+        {
+            order++;
+        }
+        if( order > buddy->maxOrder )
+        {
+            buddy->maxOrder = order;
+        }
+        pushFreeBlock( buddy, start, order );
+        buddy->freeMemory += 1 << order;
+    }
+
+    buddy->requests = 0;
+    buddy->failures = 0;
+    buddy->fragFailures = 0;
+    buddy->totalSteps = 0;
+    buddy->maxSteps = 0;
+    buddy->requestedKB = 0;
+    buddy->grantedKB = 0;
+    buddy->extFragSum = 0.0;
+    buddy->extFragMax = 0.0;
+
+    return buddy;
+}
+
+//==========================================================================
+/**
+* @brief Function frees the buddy allocator
+*
+* @param[in] buddy
+* A BuddyAllocator pointer, may be NULL
+*
+* @return NULL
+*/
+BuddyAllocator *destroyBuddyAllocator( BuddyAllocator *buddy )
+{
+    if( buddy != NULL )
+    {
+        free( buddy->freeHead );
+        free( buddy->nextFree );
+        free( buddy->prevFree );
+        free( buddy->blockOrder );
+        free( buddy->blockFree );
+        free( buddy );
+    }
+    return NULL;
+}
+
+//==========================================================================
+/**
+* @brief Function places an allocation of the given size
+*
+* @details A request that fails although enough memory is free failed
+*   for fragmentation, no free block being large enough.
+*
+* @par Algorithm
+* Function rounds the size up to a power of two, looks for a free block
+*   of that order and then of each larger one. The first found is taken
+*   off its list and split in halves, the upper half freed each time,
+*   until it is the order wanted.
+*
+* @param[in] buddy
+* A pointer to the allocator
+*
+* @param[in] size
+* The KB wanted, zero taking the smallest block
+*
+* @return the KB the block starts at, or -1 if none is free
+*/
+int buddyAlloc( BuddyAllocator *buddy, int size )
+{
+    int order = 0;
+    int found;
+    int start;
+    long steps = 1;
+
+    buddy->requests++;
+    sampleExtFrag( buddy );
+
+    while( order <= MAX_BUDDY_ORDER && ( 1 << order ) < size )
+    {
+        order++;
+    }
+
+    for( found = order; found <= buddy->maxOrder &&
+                        buddy->freeHead[ found ] == -1; found++ )
+    {
+        steps++;
+    }
+
+    if( found > buddy->maxOrder )
+    {
+        buddy->failures++;
+        if( order <= MAX_BUDDY_ORDER && buddy->freeMemory >= 1 << order )
+        {
+            buddy->fragFailures++;
+        }
+        return -1;
+    }
+
+    start = buddy->freeHead[ found ];
+    unlinkFreeBlock( buddy, start );
+    while( found > order )
+    {
+        found--;
+        pushFreeBlock( buddy, start + ( 1 << found ), found );
+        steps++;
+    }
+    buddy->blockOrder[ start ] = ( signed char )order;
+    buddy->freeMemory -= 1 << order;
+
+    buddy->totalSteps += steps;
+    if( steps > buddy->maxSteps )
+    {
+        buddy->maxSteps = steps;
+    }
+    buddy->requestedKB += size;
+    buddy->grantedKB += 1 << order;
+
+    return start;
+}
+
+//==========================================================================
+/**
+* @brief Function frees a block, joining it with its free buddies
+*
+* @par Algorithm
+* Function finds the buddy by flipping the bit of the block's size in
+*   its start. While the buddy is a free block of the same order, it is
+*   taken off its list and the two become one block of the next order,
+*   starting at the lower of the two. The block left is put on its list.
+*
+* @param[in] buddy
+* A pointer to the allocator
+*
+* @param[in] start
+* The KB the block starts at, as returned by buddyAlloc()
+*/
+void buddyFree( BuddyAllocator *buddy, int start )
+{
+    int order = buddy->blockOrder[ start ];
+    int buddyStart;
+
+    buddy->freeMemory += 1 << order;
+    buddy->blockOrder[ start ] = -1;
+
+    while( order < buddy->maxOrder )
+    {
+        buddyStart = start ^ ( 1 << order );
+        if( buddyStart + ( 1 << order ) > buddy->totalMemory ||
+            buddy->blockOrder[ buddyStart ] != order ||
+            !buddy->blockFree[ buddyStart ] )
+        {
+            break;
+        }
+        unlinkFreeBlock( buddy, buddyStart );
+        buddy->blockOrder[ buddyStart ] = -1;
+        if( buddyStart < start )
+        {
+            start = buddyStart;
+        }
+        order++;
+    }
+
+    pushFreeBlock( buddy, start, order );
+}
+
+//==========================================================================
+/**
+* @brief Function puts a free block at the head of its order's list
+*
+* @param[in] buddy
+* A pointer to the allocator
+*
+* @param[in] start
+* The KB the block starts at
+*
+* @param[in] order
+* The block is 2^order KB
+*/
+static void pushFreeBlock( BuddyAllocator *buddy, int start, int order )
+{
+    int head = buddy->freeHead[ order ];
+
+    buddy->blockOrder[ start ] = ( signed char )order;
+    buddy->blockFree[ start ] = 1;
+    buddy->prevFree[ start ] = -1;
+    buddy->nextFree[ start ] = head;
+    if( head != -1 )
+    {
+        buddy->prevFree[ head ] = start;
+    }
+    buddy->freeHead[ order ] = start;
+}
+
+//==========================================================================
+/**
+* @brief Function takes a free block off its order's list
+*
+* @param[in] buddy
+* A pointer to the allocator
+*
+* @param[in] start
+* The KB the free block starts at
+*/
+static void unlinkFreeBlock( BuddyAllocator *buddy, int start )
+{
+    int prev = buddy->prevFree[ start ];
+    int next = buddy->nextFree[ start ];
+
+    if( prev != -1 )
+    {
+        buddy->nextFree[ prev ] = next;
+    }
+    else
+    {
+        buddy->freeHead[ ( int )buddy->blockOrder[ start ] ] = next;
+    }
+    if( next != -1 )
+    {
+        buddy->prevFree[ next ] = prev;
+    }
+    buddy->blockFree[ start ] = 0;
+}
+
+//==========================================================================
+/**
+* @brief Function adds the current external fragmentation to the totals
+*
+* @param[in] buddy
+* A pointer to the allocator
+*/
+static void sampleExtFrag( BuddyAllocator *buddy )
+{
+    int order = buddy->maxOrder;
+    double extFrag;
+
+    while( order >= 0 && buddy->freeHead[ order ] == -1 )
+    {
+        order--;
+    }
+
+    extFrag = buddy->freeMemory > 0 ?
+              1.0 - ( double )( 1 << order ) / buddy->freeMemory : 0.0;
+    buddy->extFragSum += extFrag;
+    if( extFrag > buddy->extFragMax )
+    {
+        buddy->extFragMax = extFrag;
+    }
+}
+
+//==========================================================================
+// Terminating Precompiler Directives ///////////////////////////////
+//
+///// NONE
+//
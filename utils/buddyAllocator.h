@@ -0,0 +1,87 @@
+// PROGRAMMER INFORMATION ////////////////////////////////////////////
+/**
+
+Secret Number: 764819
+
+*/
+// Header File Information /////////////////////////////////////
+/**
+* @file buddyAllocator.h
+*
+* @brief Header file for buddyAllocator code
+*
+* @details Specifies functions, constants, and other information
+* related to placing allocations in memory with a binary buddy system
+*/
+// Precompiler Directives //////////////////////////////////////////
+//
+#ifndef BUDDY_ALLOCATOR_H
+#define BUDDY_ALLOCATOR_H
+//
+// Header Files ///////////////////////////////////////////////////
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include "configParser.h"
+//
+// Global Constant Definitions ////////////////////////////////////
+//
+extern const int MAX_BUDDY_ORDER;
+//
+// Data Structure Definitions (structs, enums, etc.)////////////////
+//
+/*
+  Memory is in blocks of 2^order KB, each starting at a multiple of its
+  size. blockOrder[ kb ] is the order of the block starting at kb, or -1
+  if none does, and blockFree[ kb ] whether it is free. Free blocks of
+  each order are a doubly linked list from freeHead[ order ], linked
+  through nextFree and prevFree, -1 ending it.
+
+  Every request is counted. Steps are the orders looked at plus the
+  blocks split to place one. External fragmentation is sampled as each
+  request comes in, as the share of free memory not in the largest free
+  block.
+*/
+typedef struct BuddyAllocator
+{
+    int totalMemory;
+    int freeMemory;
+    int maxOrder;
+    int *freeHead;
+    int *nextFree;
+    int *prevFree;
+    signed char *blockOrder;
+    char *blockFree;
+    long requests;
+    long failures;
+    long fragFailures;
+    long totalSteps;
+    long maxSteps;
+    long requestedKB;
+    long grantedKB;
+    double extFragSum;
+    double extFragMax;
+} BuddyAllocator;
+//
+// Free Function Prototypes ///////////////////////////////////////
+//
+//==========================================================================
+
+BuddyAllocator *createBuddyAllocator( int totalMem, Config *configData );
+
+//==========================================================================
+
+BuddyAllocator *destroyBuddyAllocator( BuddyAllocator *buddy );
+
+//==========================================================================
+
+int buddyAlloc( BuddyAllocator *buddy, int size );
+
+//==========================================================================
+
+void buddyFree( BuddyAllocator *buddy, int start );
+
+// Terminating Precompiler Directives ///////////////////////////////
+//
+#endif // BUDDY_ALLOCATOR_H
+//
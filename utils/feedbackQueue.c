@@ -0,0 +1,239 @@
+// PROGRAMMER INFORMATION ////////////////////////////////////////////
+/**
+
+Secret Number: 764819
+
+*/
+// Code Implementation File Information /////////////////////////////
+/**
+* @file feedbackQueue.c
+*
+* @brief Implementation file for feedbackQueue code
+*
+* @details Implements all functions of the multi-level feedback queue
+*/
+// Program Description/Support /////////////////////////////////////
+/*
+This program holds Ready process control blocks in one FIFO ready queue
+per priority level. The highest non-empty level runs first. A process
+that uses its whole quantum drops a level, where the quantum is twice as
+long; a process that blocks for I/O rises a level. A periodic boost
+returns every process to the top level so none starve.
+*/
+// Header Files ///////////////////////////////////////////////////
+//
+#include "feedbackQueue.h"
+//
+// Global Constant Definitions ////////////////////////////////////
+//
+///// NONE
+//
+// Free Function Prototypes ///////////////////////////////////////
+//
+//==========================================================================
+/**
+* @brief Function creates an empty feedback queue
+*
+* @param[in] numLevels
+* Number of priority levels, at least one
+*
+* @param[in] baseQuantum
+* Quantum in cycles of the top level, each lower level doubles it
+*
+* @return a pointer to the new feedback queue
+*/
+FeedbackQueue *createFeedbackQueue( int numLevels, int baseQuantum )
+{
+	FeedbackQueue *mlfq = malloc( sizeof( FeedbackQueue ) );
+	int level;
+
+	if( numLevels < 1 )
+	{
+		numLevels = 1;
+	}
+	mlfq->numLevels = numLevels;
+	mlfq->baseQuantum = baseQuantum;
+	mlfq->levels = malloc( sizeof( ReadyQueue * ) * numLevels );
+
+	for( level = 0; level < numLevels; level++ )
+	{
+		mlfq->levels[ level ] = createReadyQueue();
+	}
+	return mlfq;
+}
+
+//==========================================================================
+/**
+* @brief Function frees the feedback queue, the PCBs inside are not freed
+*
+* @param[in] mlfq
+* A FeedbackQueue pointer
+*
+* @return a freed and nulled FeedbackQueue pointer
+*/
+FeedbackQueue *destroyFeedbackQueue( FeedbackQueue *mlfq )
+{
+	int level;
+
+	for( level = 0; level < mlfq->numLevels; level++ )
+	{
+		mlfq->levels[ level ] = destroyReadyQueue( mlfq->levels[ level ] );
+	}
+	free( mlfq->levels );
+	free( mlfq );
+
+	mlfq = NULL;
+	return mlfq;
+}
+
+//==========================================================================
+/**
+* @brief Function adds a PCB to the tail of its priority level
+*
+* @param[in] mlfq
+* A FeedbackQueue pointer
+*
+* @param[in] pcb
+* The PCB to add
+*/
+void feedbackEnqueue( FeedbackQueue *mlfq, ProcessControlBlock *pcb )
+{
+	enqueuePCB( mlfq->levels[ pcb->priority ], pcb );
+}
+
+//==========================================================================
+/**
+* @brief Function removes a PCB from its priority level
+*
+* @details A PCB not queued is ignored. The PCB's priority must not have
+*   changed since it was queued, which is why levels only change while a
+*   PCB is running or blocked, or inside feedbackBoost.
+*
+* @param[in] mlfq
+* A FeedbackQueue pointer
+*
+* @param[in] pcb
+* The PCB to remove
+*/
+void feedbackRemove( FeedbackQueue *mlfq, ProcessControlBlock *pcb )
+{
+	removeQueuedPCB( mlfq->levels[ pcb->priority ], pcb );
+}
+
+//==========================================================================
+/**
+* @brief Function takes the next PCB from the highest non-empty level
+*
+* @param[in] mlfq
+* A FeedbackQueue pointer
+*
+* @return the next PCB to run, or NULL if every level is empty
+*/
+ProcessControlBlock *feedbackDequeue( FeedbackQueue *mlfq )
+{
+	int level;
+
+	for( level = 0; level < mlfq->numLevels; level++ )
+	{
+		if( mlfq->levels[ level ]->count > 0 )
+		{
+			return dequeuePCB( mlfq->levels[ level ] );
+		}
+	}
+	return NULL;
+}
+
+//==========================================================================
+/**
+* @brief Function returns the quantum of the PCB's current level
+*
+* @param[in] mlfq
+* A FeedbackQueue pointer
+*
+* @param[in] pcb
+* A PCB pointer
+*
+* @return the quantum in cycles, the base quantum doubled once per level
+*/
+int feedbackQuantum( FeedbackQueue *mlfq, ProcessControlBlock *pcb )
+{
+	return mlfq->baseQuantum << pcb->priority;
+}
+
+//==========================================================================
+/**
+* @brief Function moves a PCB down one level, the bottom level keeps it
+*
+* @param[in] mlfq
+* A FeedbackQueue pointer
+*
+* @param[in] pcb
+* A PCB pointer, not currently queued
+*/
+void feedbackDemote( FeedbackQueue *mlfq, ProcessControlBlock *pcb )
+{
+	if( pcb->priority < mlfq->numLevels - 1 )
+	{
+		pcb->priority++;
+	}
+}
+
+//==========================================================================
+/**
+* @brief Function moves a PCB up one level, the top level keeps it
+*
+* @param[in] mlfq
+* A FeedbackQueue pointer
+*
+* @param[in] pcb
+* A PCB pointer, not currently queued
+*/
+void feedbackPromote( FeedbackQueue *mlfq, ProcessControlBlock *pcb )
+{
+	if( pcb->priority > 0 )
+	{
+		pcb->priority--;
+	}
+}
+
+//==========================================================================
+/**
+* @brief Function returns every process to the top level
+*
+* @details Ready PCBs are taken from their level and requeued at the top in
+*   level order, so their relative order is kept. Running and blocked PCBs
+*   just have their level reset.
+*
+* @param[in] mlfq
+* A FeedbackQueue pointer
+*
+* @param[in] procList
+* The process list holding every PCB
+*/
+void feedbackBoost( FeedbackQueue *mlfq, ProcessList *procList )
+{
+	ProcessControlBlock *currBlock;
+	int level;
+
+	for( level = 1; level < mlfq->numLevels; level++ )
+	{
+		while( ( currBlock = dequeuePCB( mlfq->levels[ level ] ) ) != NULL )
+		{
+			currBlock->priority = 0;
+			enqueuePCB( mlfq->levels[ 0 ], currBlock );
+		}
+	}
+
+	currBlock = procListFirst( procList );
+	while( currBlock != NULL )
+	{
+		currBlock->priority = 0;
+		currBlock = currBlock->next;
+	}
+}
+
+//==========================================================================
+// Terminating Precompiler Directives ///////////////////////////////
+//
+///// NONE
+//
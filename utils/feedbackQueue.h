@@ -0,0 +1,85 @@
+// PROGRAMMER INFORMATION ////////////////////////////////////////////
+/**
+
+Secret Number: 764819
+
+*/
+// Header File Information /////////////////////////////////////
+/**
+* @file feedbackQueue.h
+*
+* @brief Header file for feedbackQueue code
+*
+* @details Specifies functions, constants, and other information
+* related to the multi-level feedback queue of process control blocks
+*/
+// Precompiler Directives //////////////////////////////////////////
+//
+#ifndef FEEDBACK_QUEUE_H
+#define FEEDBACK_QUEUE_H
+//
+// Header Files ///////////////////////////////////////////////////
+//
+#include <stdlib.h>
+#include "processList.h"
+#include "readyQueue.h"
+//
+// Global Constant Definitions ////////////////////////////////////
+//
+///// NONE
+//
+// Data Structure Definitions (structs, enums, etc.)////////////////
+//
+/*
+  Level 0 is the highest priority. A PCB's level is its priority field,
+  and it is queued at that level whenever it is Ready.
+*/
+typedef struct FeedbackQueue
+{
+	int numLevels;
+	int baseQuantum;
+	ReadyQueue **levels;
+} FeedbackQueue;
+//
+// Free Function Prototypes ///////////////////////////////////////
+//
+//==========================================================================
+
+FeedbackQueue *createFeedbackQueue( int numLevels, int baseQuantum );
+
+//==========================================================================
+
+FeedbackQueue *destroyFeedbackQueue( FeedbackQueue *mlfq );
+
+//==========================================================================
+
+void feedbackEnqueue( FeedbackQueue *mlfq, ProcessControlBlock *pcb );
+
+//==========================================================================
+
+void feedbackRemove( FeedbackQueue *mlfq, ProcessControlBlock *pcb );
+
+//==========================================================================
+
+ProcessControlBlock *feedbackDequeue( FeedbackQueue *mlfq );
+
+//==========================================================================
+
+int feedbackQuantum( FeedbackQueue *mlfq, ProcessControlBlock *pcb );
+
+//==========================================================================
+
+void feedbackDemote( FeedbackQueue *mlfq, ProcessControlBlock *pcb );
+
+//==========================================================================
+
+void feedbackPromote( FeedbackQueue *mlfq, ProcessControlBlock *pcb );
+
+//==========================================================================
+
+void feedbackBoost( FeedbackQueue *mlfq, ProcessList *procList );
+
+// Terminating Precompiler Directives ///////////////////////////////
+//
+#endif // FEEDBACK_QUEUE_H
+//
@@ -0,0 +1,265 @@
+// PROGRAMMER INFORMATION ////////////////////////////////////////////
+/**
+
+Secret Number: 764819
+
+*/
+// Code Implementation File Information /////////////////////////////
+/**
+* @file intTrace.c
+*
+* @brief Implementation file for intTrace code
+*
+* @details Implements all functions of the interrupt trace
+*/
+// Program Description/Support /////////////////////////////////////
+/*
+Whether an I/O interrupt is seen before or after a given P cycle depends
+on when its thread finishes, so two runs of one preemptive configuration
+rarely match. A trace names the point every interrupt was delivered at:
+the number of P cycles the CPU had run, and which check for interrupts
+since the last cycle it was. Recording writes one "cycle check pid" line
+per interrupt delivered. Replaying reads those lines back so the
+dispatcher can hand each interrupt over at the point it was recorded at.
+*/
+// Header Files ///////////////////////////////////////////////////
+//
+#include "intTrace.h"
+//
+// Global Constant Definitions ////////////////////////////////////
+//
+///// NONE
+//
+// Free Function Prototypes ///////////////////////////////////////
+//
+static int readTraceFile( char *replayPath, IntTrace *trace );
+//
+//==========================================================================
+/**
+* @brief Function creates a trace to record to, replay from, or both
+*
+* @details No trace is needed if neither path is given. Recording while
+*   replaying writes the points the replay delivered at.
+*
+* @param[in] recordPath
+* Path of the file to record to, empty to not record
+*
+* @param[in] replayPath
+* Path of the file to replay from, empty to not replay
+*
+* @param[out] status
+* Set to no error message, file not found if the replay file cannot be
+*   read, or open file fail if the record file cannot be written
+*
+* @return a pointer to the trace, or NULL if there is none
+*/
+IntTrace *createIntTrace( char *recordPath, char *replayPath, int *status )
+{
+    IntTrace *trace;
+
+    *status = NO_ERROR_MSG;
+    if( recordPath[ 0 ] == NUL && replayPath[ 0 ] == NUL )
+    {
+        return NULL;
+    }
+
+    trace = malloc( sizeof( IntTrace ) );
+    trace->recordFile = NULL;
+    trace->replaying = 0;
+    trace->entries = NULL;
+    trace->numEntries = 0;
+    trace->nextEntry = 0;
+    trace->cycle = 0;
+    trace->check = 0;
+    trace->lastCheckIdle = 0;
+
+    if( replayPath[ 0 ] != NUL )
+    {
+        *status = readTraceFile( replayPath, trace );
+        if( *status != NO_ERROR_MSG )
+        {
+            return destroyIntTrace( trace );
+        }
+        trace->replaying = 1;
+    }
+
+    if( recordPath[ 0 ] != NUL )
+    {
+        trace->recordFile = fopen( recordPath, "w" );
+        if( trace->recordFile == NULL )
+        {
+            *status = OPEN_FILE_FAIL;
+            return destroyIntTrace( trace );
+        }
+    }
+
+    return trace;
+}
+
+//==========================================================================
+/**
+* @brief Function reads every entry of a recorded trace
+*
+* @param[in] replayPath
+* Path of the recorded trace
+*
+* @param[out] trace
+* An IntTrace pointer receiving the entries, in the order recorded
+*
+* @return no error message if the file was read, file not found if it
+*   could not be opened, invalid data if a line is not an entry
+*/
+static int readTraceFile( char *replayPath, IntTrace *trace )
+{
+    FILE *replayFile = openFile( replayPath );
+    char line[ 100 ];
+    int capacity = 64;
+    TraceEntry *entry;
+
+    if( replayFile == NULL )
+    {
+        return FILE_NOT_FOUND_ERR;
+    }
+
+    trace->entries = malloc( sizeof( TraceEntry ) * capacity );
+
+    while( fgets( line, sizeof( line ), replayFile ) != NULL )
+    {
+        if( trace->numEntries == capacity )
+        {
+            capacity *= 2;
+            trace->entries = realloc( trace->entries,
+                                      sizeof( TraceEntry ) * capacity );
+        }
+
+        entry = &trace->entries[ trace->numEntries ];
+        if( sscanf( line, "%ld %d %d", &entry->cycle, &entry->check,
+                    &entry->pid ) != 3 )
+        {
+            closeFile( replayFile );
+            return INVALID_DATA;
+        }
+        trace->numEntries++;
+    }
+    closeFile( replayFile );
+
+    return NO_ERROR_MSG;
+}
+
+//==========================================================================
+/**
+* @brief Function closes the record file and frees the trace
+*
+* @param[in] trace
+* An IntTrace pointer, may be NULL
+*
+* @return NULL
+*/
+IntTrace *destroyIntTrace( IntTrace *trace )
+{
+    if( trace != NULL )
+    {
+        if( trace->recordFile != NULL )
+        {
+            fclose( trace->recordFile );
+        }
+        free( trace->entries );
+        free( trace );
+    }
+    return NULL;
+}
+
+//==========================================================================
+/**
+* @brief Function counts one P cycle run by the CPU
+*
+* @param[in] trace
+* An IntTrace pointer, may be NULL
+*/
+void traceCycle( IntTrace *trace )
+{
+    if( trace != NULL )
+    {
+        trace->cycle++;
+        trace->check = 0;
+        trace->lastCheckIdle = 0;
+    }
+}
+
+//==========================================================================
+/**
+* @brief Function counts one check for interrupts
+*
+* @details However many times the idle CPU checks in a row, it counts as
+*   one check, since how often it spins depends on thread timing.
+*
+* @param[in] trace
+* An IntTrace pointer, may be NULL
+*
+* @param[in] idle
+* Nonzero if the CPU has no process running
+*/
+void traceCheck( IntTrace *trace, int idle )
+{
+    if( trace == NULL || ( idle && trace->lastCheckIdle ) )
+    {
+        return;
+    }
+    trace->check++;
+    trace->lastCheckIdle = idle;
+}
+
+//==========================================================================
+/**
+* @brief Function returns which process the trace delivers to next here
+*
+* @param[in] trace
+* An IntTrace pointer, may be NULL
+*
+* @return the pid of the next recorded interrupt if it was delivered at
+*   the current point, -1 if there is none to deliver here
+*/
+int traceReplayPid( IntTrace *trace )
+{
+    TraceEntry *entry;
+
+    if( trace == NULL || !trace->replaying ||
+        trace->nextEntry == trace->numEntries )
+    {
+        return -1;
+    }
+
+    entry = &trace->entries[ trace->nextEntry ];
+    if( entry->cycle != trace->cycle || entry->check != trace->check )
+    {
+        return -1;
+    }
+
+    trace->nextEntry++;
+    return entry->pid;
+}
+
+//==========================================================================
+/**
+* @brief Function records an interrupt delivered at the current point
+*
+* @param[in] trace
+* An IntTrace pointer, may be NULL
+*
+* @param[in] pid
+* The process the interrupt was for
+*/
+void traceRecord( IntTrace *trace, int pid )
+{
+    if( trace != NULL && trace->recordFile != NULL )
+    {
+        fprintf( trace->recordFile, "%ld %d %d\n", trace->cycle,
+                 trace->check, pid );
+    }
+}
+
+//==========================================================================
+// Terminating Precompiler Directives ///////////////////////////////
+//
+///// NONE
+//
@@ -0,0 +1,90 @@
+// PROGRAMMER INFORMATION ////////////////////////////////////////////
+/**
+
+Secret Number: 764819
+
+*/
+// Header File Information /////////////////////////////////////
+/**
+* @file intTrace.h
+*
+* @brief Header file for intTrace code
+*
+* @details Specifies functions, constants, and other information
+* related to recording and replaying the order interrupts arrive in
+*/
+// Precompiler Directives //////////////////////////////////////////
+//
+#ifndef INT_TRACE_H
+#define INT_TRACE_H
+//
+// Header Files ///////////////////////////////////////////////////
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include "utilities.h"
+//
+// Global Constant Definitions ////////////////////////////////////
+//
+///// NONE
+//
+// Data Structure Definitions (structs, enums, etc.)////////////////
+//
+/*
+  Where one interrupt was delivered: after how many P cycles the CPU had
+  run, at which check for interrupts since the last of those cycles, and
+  for which process
+*/
+typedef struct TraceEntry
+{
+    long cycle;
+    int check;
+    int pid;
+} TraceEntry;
+
+/*
+  A check while the CPU is idle counts once however often the idle CPU
+  looks, so points are the same whether or not the idle time is real.
+*/
+typedef struct IntTrace
+{
+    FILE *recordFile;
+    int replaying;
+    TraceEntry *entries;
+    int numEntries;
+    int nextEntry;
+    long cycle;
+    int check;
+    int lastCheckIdle;
+} IntTrace;
+//
+// Free Function Prototypes ///////////////////////////////////////
+//
+//==========================================================================
+
+IntTrace *createIntTrace( char *recordPath, char *replayPath, int *status );
+
+//==========================================================================
+
+IntTrace *destroyIntTrace( IntTrace *trace );
+
+//==========================================================================
+
+void traceCycle( IntTrace *trace );
+
+//==========================================================================
+
+void traceCheck( IntTrace *trace, int idle );
+
+//==========================================================================
+
+int traceReplayPid( IntTrace *trace );
+
+//==========================================================================
+
+void traceRecord( IntTrace *trace, int pid );
+
+// Terminating Precompiler Directives ///////////////////////////////
+//
+#endif // INT_TRACE_H
+//
@@ -18,71 +18,413 @@ Secret Number: 764819
 */
 // Header Files ///////////////////////////////////////////////////
 //
+#include <sched.h>
+#include <sys/time.h>
 #include "interruptQueue.h"
 //
 // Global Constant Definitions ////////////////////////////////////
 //
-///// NONE
+const int INT_BATCH_BUCKETS = 16;
+// the idle dispatcher looks again this often even if no post woke it
+const int IDLE_WAIT_USEC = 10000;
+
+// interrupts are made by I/O threads and freed by the dispatcher
+static ObjectPool interruptPool = { sizeof( Interrupt ),
+                                    PTHREAD_MUTEX_INITIALIZER };
 //
 // Free Function Prototypes ///////////////////////////////////////
 //
+static Interrupt *takePosted( InterruptQueue *queue );
+static void collectPosted( InterruptQueue *queue );
+static int anyPosted( InterruptQueue *queue );
+static int compareInts( Interrupt *first, Interrupt *second );
+static void swapInts( InterruptQueue *queue, int first, int second );
+static int siftIntUp( InterruptQueue *queue, int index );
+static void siftIntDown( InterruptQueue *queue, int index );
+static Interrupt *removeIntAt( InterruptQueue *queue, int index );
+static int countDue( InterruptQueue *queue, int index, double currTime,
+                     int limit );
+//
 //==========================================================================
 /**
-* @brief
+* @brief Function posts an interrupt, from any thread, without a lock
 *
-* @details
+* @details The interrupt waits in the posted list until the dispatcher
+*   next looks at the queue.
 *
 * @par Algorithm
+*   Function swaps the interrupt in as the new postHead, then links the
+*   old postHead to it. Between the two steps the dispatcher sees the
+*   list end early and picks the interrupt up on a later look. If the
+*   dispatcher is asleep waiting for a post, it is woken. The post is
+*   counted in posting from before it is seen until the queue is last
+*   touched.
 *
+* @param[in] queue
+* An InterruptQueue pointer
 *
-* @param[in]
+* @param[in] interrupt
+* The interrupt to post
+*/
+void enqueueInt( InterruptQueue *queue, Interrupt *interrupt )
+{
+    Interrupt *prevInt;
+
+    __atomic_add_fetch( &queue->posting, 1, __ATOMIC_SEQ_CST );
+    __atomic_store_n( &interrupt->postNext, NULL, __ATOMIC_RELAXED );
+    prevInt = __atomic_exchange_n( &queue->postHead, interrupt,
+                                   __ATOMIC_SEQ_CST );
+    __atomic_store_n( &prevInt->postNext, interrupt, __ATOMIC_RELEASE );
+
+    // ordered after the exchange, so a waiter either sees the post or us
+    if( __atomic_load_n( &queue->idleWaiting, __ATOMIC_SEQ_CST ) )
+    {
+        pthread_mutex_lock( &queue->idleLock );
+        pthread_cond_signal( &queue->posted );
+        pthread_mutex_unlock( &queue->idleLock );
+    }
+
+    __atomic_sub_fetch( &queue->posting, 1, __ATOMIC_SEQ_CST );
+}
+
+//==========================================================================
+/**
+* @brief Function takes the oldest posted interrupt off the posted list
 *
+* @details Only the dispatcher calls this.
 *
-* @return
+* @par Algorithm
+*   Function skips the stub at postTail. The interrupt at postTail can be
+*   taken once another follows it. If it is the last one posted, the stub
+*   is posted behind it so it can be taken; if a post is part way done,
+*   nothing is taken until it finishes.
+*
+* @param[in] queue
+* An InterruptQueue pointer
+*
+* @return the interrupt, or NULL if none can be taken yet
 */
-void enqueueInt( InterruptQueue *queue, Interrupt *interrupt )
+static Interrupt *takePosted( InterruptQueue *queue )
 {
-    if( queue->first == NULL && queue->count == 0 )
+    Interrupt *tail = queue->postTail;
+    Interrupt *next = __atomic_load_n( &tail->postNext, __ATOMIC_ACQUIRE );
+
+    if( tail == &queue->postStub )
     {
-        queue->first = interrupt;
-        queue->count++;
-        return;
+        if( next == NULL )
+        {
+            return NULL;
+        }
+        queue->postTail = next;
+        tail = next;
+        next = __atomic_load_n( &tail->postNext, __ATOMIC_ACQUIRE );
     }
 
-    Interrupt *currInt = queue->first;
-    while( currInt->next != NULL )
+    if( next == NULL )
     {
-        currInt = currInt->next;
+        if( tail != __atomic_load_n( &queue->postHead, __ATOMIC_ACQUIRE ) )
+        {
+            return NULL;
+        }
+        enqueueInt( queue, &queue->postStub );
+        next = __atomic_load_n( &tail->postNext, __ATOMIC_ACQUIRE );
+        if( next == NULL )
+        {
+            return NULL;
+        }
     }
 
-    currInt->next = interrupt;
-    queue->count++;
-    return;
+    queue->postTail = next;
+    return tail;
 }
 
 //==========================================================================
 /**
-* @brief
+* @brief Function moves every posted interrupt into the heap
 *
-* @details
+* @details Only the dispatcher calls this. With nothing posted it costs
+*   one atomic load.
 *
 * @par Algorithm
+*   Function takes each posted interrupt in the order posted, numbers it
+*   so interrupts due together stay in post order, and sifts it up from
+*   the last slot.
+*
+* @param[in] queue
+* An InterruptQueue pointer
+*/
+static void collectPosted( InterruptQueue *queue )
+{
+    Interrupt *interrupt;
+
+    while( ( interrupt = takePosted( queue ) ) != NULL )
+    {
+        if( queue->count == queue->capacity )
+        {
+            queue->capacity *= 2;
+            queue->heap = realloc( queue->heap,
+                                   sizeof( Interrupt * ) * queue->capacity );
+        }
+
+        interrupt->seq = queue->collected++;
+        queue->heap[ queue->count ] = interrupt;
+        queue->count++;
+        siftIntUp( queue, queue->count - 1 );
+    }
+}
+
+//==========================================================================
+/**
+* @brief Function orders interrupts by due time, then by collection order
 *
+* @param[in] first
+* The first interrupt
 *
-* @param[out]
+* @param[in] second
+* The second interrupt
 *
+* @return negative if first is delivered before second, positive if after
+*/
+static int compareInts( Interrupt *first, Interrupt *second )
+{
+    if( first->dueTime != second->dueTime )
+    {
+        return first->dueTime < second->dueTime ? -1 : 1;
+    }
+    return first->seq < second->seq ? -1 : first->seq > second->seq;
+}
+
+//==========================================================================
+/**
+* @brief Function swaps two heap slots
 *
-* @return
+* @param[in] queue
+* An InterruptQueue pointer
+*
+* @param[in] first
+* Index of the first slot
+*
+* @param[in] second
+* Index of the second slot
 */
-Interrupt *dequeueInt( InterruptQueue *queue )
+static void swapInts( InterruptQueue *queue, int first, int second )
 {
-    Interrupt *returnInt = queue->first;
-    queue->first = queue->first->next;
-    queue->count--;
+    Interrupt *temp = queue->heap[ first ];
 
+    queue->heap[ first ] = queue->heap[ second ];
+    queue->heap[ second ] = temp;
+}
+
+//==========================================================================
+/**
+* @brief Function moves a slot toward the root until its parent is earlier
+*
+* @param[in] queue
+* An InterruptQueue pointer
+*
+* @param[in] index
+* Index of the slot to move
+*
+* @return the final index of the slot
+*/
+static int siftIntUp( InterruptQueue *queue, int index )
+{
+    int parent;
+
+    while( index > 0 )
+    {
+        parent = ( index - 1 ) / 2;
+
+        if( compareInts( queue->heap[ index ], queue->heap[ parent ] ) >= 0 )
+        {
+            break;
+        }
+        swapInts( queue, index, parent );
+        index = parent;
+    }
+    return index;
+}
+
+//==========================================================================
+/**
+* @brief Function moves a slot toward the leaves until both children are
+*   later
+*
+* @param[in] queue
+* An InterruptQueue pointer
+*
+* @param[in] index
+* Index of the slot to move
+*/
+static void siftIntDown( InterruptQueue *queue, int index )
+{
+    int child, earliest;
+
+    while( 1 )
+    {
+        earliest = index;
+        child = 2 * index + 1;
+
+        if( child < queue->count &&
+            compareInts( queue->heap[ child ], queue->heap[ earliest ] ) < 0 )
+        {
+            earliest = child;
+        }
+        child++;
+        if( child < queue->count &&
+            compareInts( queue->heap[ child ], queue->heap[ earliest ] ) < 0 )
+        {
+            earliest = child;
+        }
+
+        if( earliest == index )
+        {
+            return;
+        }
+        swapInts( queue, index, earliest );
+        index = earliest;
+    }
+}
+
+//==========================================================================
+/**
+* @brief Function removes the interrupt in any slot of the heap
+*
+* @details Function moves the last slot into the removed one, then sifts
+*   it in whichever direction restores the heap order.
+*
+* @param[in] queue
+* An InterruptQueue pointer
+*
+* @param[in] index
+* Index of the slot to remove
+*
+* @return the removed interrupt
+*/
+static Interrupt *removeIntAt( InterruptQueue *queue, int index )
+{
+    Interrupt *returnInt = queue->heap[ index ];
+
+    queue->count--;
+    if( index < queue->count )
+    {
+        queue->heap[ index ] = queue->heap[ queue->count ];
+        if( siftIntUp( queue, index ) == index )
+        {
+            siftIntDown( queue, index );
+        }
+    }
     return returnInt;
 }
 
+//==========================================================================
+/**
+* @brief Function counts the interrupts due under a slot, up to a limit
+*
+* @details A slot is never due before its parent, so only due slots and
+*   their children are looked at, and no more once limit are found.
+*
+* @param[in] queue
+* An InterruptQueue pointer
+*
+* @param[in] index
+* Index of the slot to count from
+*
+* @param[in] currTime
+* The current time in seconds
+*
+* @param[in] limit
+* The most interrupts to count
+*
+* @return the number of due interrupts found
+*/
+static int countDue( InterruptQueue *queue, int index, double currTime,
+                     int limit )
+{
+    int due;
+
+    if( index >= queue->count || limit == 0 ||
+        queue->heap[ index ]->dueTime > currTime )
+    {
+        return 0;
+    }
+
+    due = 1;
+    due += countDue( queue, 2 * index + 1, currTime, limit - due );
+    due += countDue( queue, 2 * index + 2, currTime, limit - due );
+    return due;
+}
+
+//==========================================================================
+/**
+* @brief Function takes the earliest interrupt due by the given time
+*
+* @details Only the dispatcher calls this. However the I/O threads race
+*   to post, interrupts due together come out in the order their I/O
+*   ended.
+*
+* @param[in] queue
+* An InterruptQueue pointer
+*
+* @param[in] currTime
+* The current time in seconds
+*
+* @return the interrupt, or NULL if none is due
+*/
+Interrupt *dequeueInt( InterruptQueue *queue, double currTime )
+{
+    collectPosted( queue );
+
+    if( queue->count == 0 || queue->heap[ 0 ]->dueTime > currTime )
+    {
+        return NULL;
+    }
+    return removeIntAt( queue, 0 );
+}
+
+//==========================================================================
+/**
+* @brief Function removes the interrupt for a process, due or not
+*
+* @details Replaying a trace delivers interrupts in the recorded order
+*   rather than by due time. Only the dispatcher calls this.
+*
+* @param[in] queue
+* An InterruptQueue pointer
+*
+* @param[in] pid
+* The process to take an interrupt for
+*
+* @return the interrupt, or NULL if none is queued for the process
+*/
+Interrupt *takeIntForPid( InterruptQueue *queue, int pid )
+{
+    Interrupt *returnInt = NULL;
+    int index;
+
+    collectPosted( queue );
+
+    // a process has one I/O at a time, so the earliest is the only one
+    for( index = 0; index < queue->count; index++ )
+    {
+        if( queue->heap[ index ]->pcb->pid == pid &&
+            ( returnInt == NULL ||
+              compareInts( queue->heap[ index ], returnInt ) < 0 ) )
+        {
+            returnInt = queue->heap[ index ];
+        }
+    }
+
+    for( index = 0; returnInt != NULL && index < queue->count; index++ )
+    {
+        if( queue->heap[ index ] == returnInt )
+        {
+            return removeIntAt( queue, index );
+        }
+    }
+    return NULL;
+}
+
 //==========================================================================
 /**
 * @brief
@@ -97,15 +439,30 @@ Interrupt *dequeueInt( InterruptQueue *queue )
 *
 * @return
 */
-Interrupt *createInterrupt( ProcessControlBlock *pcb )
+Interrupt *createInterrupt( ProcessControlBlock *pcb, double dueTime )
 {
-    Interrupt *returnInt = malloc( sizeof( Interrupt ) );
+    Interrupt *returnInt = poolAlloc( &interruptPool );
     returnInt->pcb = pcb;
+    returnInt->dueTime = dueTime;
     returnInt->next = NULL;
+    returnInt->postNext = NULL;
+    returnInt->seq = 0;
 
     return returnInt;
 }
 
+//==========================================================================
+/**
+* @brief Function gives a delivered interrupt back to the pool
+*
+* @param[in] interrupt
+* An Interrupt pointer from createInterrupt()
+*/
+void freeInterrupt( Interrupt *interrupt )
+{
+    poolFree( &interruptPool, interrupt );
+}
+
 //==========================================================================
 /**
 * @brief
@@ -123,12 +480,214 @@ Interrupt *createInterrupt( ProcessControlBlock *pcb )
 InterruptQueue *createInterruptQueue()
 {
     InterruptQueue *returnQueue = malloc( sizeof( InterruptQueue ) );
-    returnQueue->first = NULL;
     returnQueue->count = 0;
+    returnQueue->capacity = 16;
+    returnQueue->heap = malloc( sizeof( Interrupt * ) * returnQueue->capacity );
+    returnQueue->collected = 0;
+    returnQueue->postStub.postNext = NULL;
+    returnQueue->postHead = &returnQueue->postStub;
+    returnQueue->postTail = &returnQueue->postStub;
+    returnQueue->idleWaiting = 0;
+    returnQueue->posting = 0;
+    pthread_mutex_init( &returnQueue->idleLock, NULL );
+    pthread_cond_init( &returnQueue->posted, NULL );
+    returnQueue->batchSize = 1;
+    returnQueue->batchDelay = 0;
+    returnQueue->cycle = 0;
+    returnQueue->heldSince = -1;
+    returnQueue->batchCounts = calloc( INT_BATCH_BUCKETS, sizeof( int ) );
+    returnQueue->trace = NULL;
+    returnQueue->mmu = NULL;
 
     return returnQueue;
 }
 
+//==========================================================================
+/**
+* @brief Function returns when the next interrupt is due
+*
+* @param[in] queue
+* An InterruptQueue pointer
+*
+* @return the due time of the first interrupt in seconds, or -1 if the
+*   queue is empty
+*/
+double nextIntTime( InterruptQueue *queue )
+{
+    collectPosted( queue );
+
+    return queue->count > 0 ? queue->heap[ 0 ]->dueTime : -1.0;
+}
+
+//==========================================================================
+/**
+* @brief Function sleeps until an interrupt has been posted
+*
+* @details The idle dispatcher calls this instead of checking over and
+*   over while every process waits on I/O. It returns at once if an
+*   interrupt is already posted and not yet collected. Each sleep is
+*   bounded by IDLE_WAIT_USEC, so a missed wake up only costs that long.
+*
+* @param[in] queue
+* An InterruptQueue pointer
+*/
+void waitForPosted( InterruptQueue *queue )
+{
+    struct timeval now;
+    struct timespec until;
+
+    pthread_mutex_lock( &queue->idleLock );
+    __atomic_store_n( &queue->idleWaiting, 1, __ATOMIC_SEQ_CST );
+
+    while( !anyPosted( queue ) )
+    {
+        gettimeofday( &now, NULL );
+        now.tv_usec += IDLE_WAIT_USEC;
+        until.tv_sec = now.tv_sec + now.tv_usec / 1000000;
+        until.tv_nsec = ( now.tv_usec % 1000000 ) * 1000L;
+        pthread_cond_timedwait( &queue->posted, &queue->idleLock, &until );
+    }
+
+    __atomic_store_n( &queue->idleWaiting, 0, __ATOMIC_SEQ_CST );
+    pthread_mutex_unlock( &queue->idleLock );
+}
+
+//==========================================================================
+/**
+* @brief Function returns whether any posted interrupt is not collected
+*
+* @details postHead is read rather than the stub's link. A poster swaps
+*   postHead before it reads idleWaiting, both in one total order with
+*   the waiter's store and this read, so either the poster sees the
+*   waiter or the waiter sees the post. The link is stored later and
+*   could be missed.
+*
+* @param[in] queue
+* An InterruptQueue pointer
+*
+* @return 1 if one is, 0 otherwise
+*/
+static int anyPosted( InterruptQueue *queue )
+{
+    return queue->postTail != &queue->postStub ||
+           __atomic_load_n( &queue->postHead, __ATOMIC_SEQ_CST )
+           != &queue->postStub;
+}
+
+//==========================================================================
+/**
+* @brief Function decides whether the due interrupts wait for more
+*
+* @details Interrupting the running process for each I/O that ends costs
+*   it a dispatch per interrupt, so due interrupts are held until enough
+*   are due to deliver together, or until the first has waited long
+*   enough. With the defaults of a batch size of one and no delay nothing
+*   is held. A replay delivers where its trace says, so it holds nothing.
+*
+* @param[in] queue
+* An InterruptQueue pointer
+*
+* @param[in] currTime
+* The current time in seconds
+*
+* @return 1 if the due interrupts are held, 0 if they are delivered now
+*/
+int holdInterrupts( InterruptQueue *queue, double currTime )
+{
+    int due;
+
+    if( queue->trace != NULL && queue->trace->replaying )
+    {
+        return 0;
+    }
+
+    collectPosted( queue );
+    due = countDue( queue, 0, currTime, queue->batchSize );
+
+    if( due == 0 || due == queue->batchSize )
+    {
+        queue->heldSince = -1;
+        return 0;
+    }
+
+    if( queue->heldSince == -1 )
+    {
+        queue->heldSince = queue->cycle;
+    }
+    if( queue->cycle - queue->heldSince >= queue->batchDelay )
+    {
+        queue->heldSince = -1;
+        return 0;
+    }
+    return 1;
+}
+
+//==========================================================================
+/**
+* @brief Function counts one P cycle run while interrupts may be held
+*
+* @param[in] queue
+* An InterruptQueue pointer
+*/
+void countIntCycle( InterruptQueue *queue )
+{
+    queue->cycle++;
+}
+
+//==========================================================================
+/**
+* @brief Function counts one batch of interrupts delivered together
+*
+* @param[in] queue
+* An InterruptQueue pointer
+*
+* @param[in] size
+* The number of interrupts in the batch, at least one
+*/
+void recordIntBatch( InterruptQueue *queue, int size )
+{
+    if( size > INT_BATCH_BUCKETS )
+    {
+        size = INT_BATCH_BUCKETS;
+    }
+    queue->batchCounts[ size - 1 ]++;
+}
+
+//==========================================================================
+/**
+* @brief Function frees an interrupt queue and any interrupts left in it
+*
+* @param[in] queue
+* An InterruptQueue pointer
+*
+* @return NULL
+*/
+InterruptQueue *destroyInterruptQueue( InterruptQueue *queue )
+{
+    int index;
+
+    // an I/O thread whose interrupt was taken may not have returned yet
+    while( __atomic_load_n( &queue->posting, __ATOMIC_SEQ_CST ) > 0 )
+    {
+        sched_yield();
+    }
+
+    collectPosted( queue );
+    for( index = 0; index < queue->count; index++ )
+    {
+        freeInterrupt( queue->heap[ index ] );
+    }
+    free( queue->heap );
+
+    destroyIntTrace( queue->trace );
+    pthread_cond_destroy( &queue->posted );
+    pthread_mutex_destroy( &queue->idleLock );
+    free( queue->batchCounts );
+    free( queue );
+
+    return NULL;
+}
+
 
 //==========================================================================
 // Terminating Precompiler Directives ///////////////////////////////
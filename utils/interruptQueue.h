@@ -21,24 +21,74 @@ Secret Number: 764819
 // Header Files ///////////////////////////////////////////////////
 //
 #include <stdlib.h>
+#include <pthread.h>
 #include "processList.h"
+#include "intTrace.h"
+#include "objectPool.h"
 //
 // Global Constant Definitions ////////////////////////////////////
 //
-///// NONE
+extern const int INT_BATCH_BUCKETS;
 //
 // Data Structure Definitions (structs, enums, etc.)////////////////
 //
+/*
+  An interrupt is delivered once the clock reaches its due time, the
+  simulated time its I/O ends. I/O threads post interrupts already due,
+  a virtual clock run posts them ahead of time. seq is the order it was
+  collected in, postNext links the posted interrupts not yet collected
+  and next links a batch being delivered.
+*/
 typedef struct Interrupt
 {
     struct Interrupt *next;
+    struct Interrupt *postNext;
     ProcessControlBlock *pcb;
+    double dueTime;
+    long seq;
 } Interrupt;
 
+struct MMUList;
+
+/*
+  Any thread posts to the intrusive multi-producer, single-consumer list
+  at postHead without a lock. Only the dispatcher takes interrupts; it
+  collects the posted ones from postTail into heap, a binary min-heap of
+  count interrupts ordered by due time, then by seq, numbered from
+  collected. postStub keeps the posted list from ever being empty. An
+  idle dispatcher sleeps on posted, and idleWaiting tells posting threads
+  to wake it. posting counts the posts under way, the queue is not freed
+  until none is, since a poster may still look at idleWaiting after the
+  dispatcher has taken its interrupt. trace is NULL unless the run records or replays where its
+  interrupts are delivered. mmu holds the allocations a process ending on
+  an interrupt frees, or is NULL.
+
+  A running process is interrupted once batchSize interrupts are due, or
+  once the first due has been held batchDelay P cycles. cycle counts
+  those cycles, heldSince is the cycle holding began, or -1, and
+  batchCounts[ n - 1 ] counts the batches of n interrupts delivered, the
+  last bucket counting every larger batch too.
+*/
 typedef struct InterruptQueue
 {
 	int count;
-	Interrupt *first;
+	int capacity;
+	Interrupt **heap;
+	long collected;
+	Interrupt *postHead;
+	Interrupt *postTail;
+	Interrupt postStub;
+	int idleWaiting;
+	int posting;
+	pthread_mutex_t idleLock;
+	pthread_cond_t posted;
+	int batchSize;
+	int batchDelay;
+	long cycle;
+	long heldSince;
+	int *batchCounts;
+	IntTrace *trace;
+	struct MMUList *mmu;
 } InterruptQueue;
 //
 // Free Function Prototypes ///////////////////////////////////////
@@ -49,16 +99,48 @@ void enqueueInt( InterruptQueue *queue, Interrupt *interrupt );
 
 //==========================================================================
 
-Interrupt *dequeueInt( InterruptQueue *queue );
+Interrupt *dequeueInt( InterruptQueue *queue, double currTime );
+
+//==========================================================================
+
+Interrupt *takeIntForPid( InterruptQueue *queue, int pid );
 
 //==========================================================================
 
-Interrupt *createInterrupt( ProcessControlBlock *pcb );
+Interrupt *createInterrupt( ProcessControlBlock *pcb, double dueTime );
+
+//==========================================================================
+
+void freeInterrupt( Interrupt *interrupt );
 
 //==========================================================================
 
 InterruptQueue *createInterruptQueue();
 
+//==========================================================================
+
+double nextIntTime( InterruptQueue *queue );
+
+//==========================================================================
+
+void waitForPosted( InterruptQueue *queue );
+
+//==========================================================================
+
+int holdInterrupts( InterruptQueue *queue, double currTime );
+
+//==========================================================================
+
+void countIntCycle( InterruptQueue *queue );
+
+//==========================================================================
+
+void recordIntBatch( InterruptQueue *queue, int size );
+
+//==========================================================================
+
+InterruptQueue *destroyInterruptQueue( InterruptQueue *queue );
+
 // Terminating Precompiler Directives ///////////////////////////////
 //
 #endif // INT_QUEUE_H
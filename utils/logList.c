@@ -48,7 +48,10 @@ LogList *logListCreate() {
     LogList *list = malloc( sizeof( LogList ));
 
     list->first = NULL;
+    list->last = NULL;
     list->count = 0;
+    initClock( &list->clock );
+    pthread_mutex_init( &list->lock, NULL );
 
     return list;
 }
@@ -88,13 +91,12 @@ LogNode *createLogNode( char *logStr )
 /**
 * @brief Function appends a node to the end of a list
 *
-* @details Function finds ending node in list and appends given node
+* @details Function links the given node after the list's last node
 *
 * @par Algorithm
-*   Function takes a node and a list, finds the ending node in the list,
-*   and links that last node to the given node, making the given node the
-*   new last node in the list. If the list is empty, it makes the given
-*   node the head of the list.
+*   Function takes a node and a list, links the list's last node to the
+*   given node, making the given node the new last node in the list.
+*   If the list is empty, it makes the given node the head of the list.
 *
 * @param[in] list
 * A metadataList pointer
@@ -107,18 +109,13 @@ void addLogNode( LogList *list, LogNode *node )
     if( list->first == NULL && list->count == 0 )
     {
         list->first = node;
+        list->last = node;
         list->count++;
         return;
     }
 
-    LogNode *currNode = list->first;
-
-    while( currNode->next != NULL )
-    {
-        currNode = currNode->next;
-    }
-
-    currNode->next = node;
+    list->last->next = node;
+    list->last = node;
     list->count++;
 
     return;
@@ -160,6 +157,7 @@ static void freeLogNodes( LogList *list )
     free( list->first );
 
     list->first = NULL;
+    list->last = NULL;
     list->count = 0;
 }
 
@@ -182,6 +180,7 @@ static void freeLogNodes( LogList *list )
 LogList *logListDestroy( LogList *list )
 {
     freeLogNodes( list );
+    pthread_mutex_destroy( &list->lock );
     free( list );
 
     list = NULL;
@@ -20,7 +20,9 @@ Secret Number: 764819
 //
 // Header Files ///////////////////////////////////////////////////
 //
+#include <pthread.h>
 #include "utilities.h"
+#include "simtimer.h"
 //
 // Global Constant Definitions ////////////////////////////////////
 //
@@ -38,6 +40,9 @@ typedef struct LogList
 {
 	int count;
 	LogNode *first;
+	LogNode *last;
+	SimClock clock;
+	pthread_mutex_t lock;
 } LogList;
 //
 // Free Function Prototypes ///////////////////////////////////////
@@ -56,7 +61,7 @@ LogList *logListCreate();
 LogNode *createLogNode( char *logStr );
 
 /*
-  Finds end of list and adds link to given node
+  Links given node after the last node in the list
 */
 void addLogNode( LogList *list, LogNode *node );
 
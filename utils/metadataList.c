@@ -25,6 +25,10 @@ operating system metadata.
 #include "processList.h"
 #include "utilities.h"
 //
+// Global Constant Definitions ////////////////////////////////////
+//
+const int MAX_MEM_VALUE = 99999999;
+//
 // Free Function Prototypes ///////////////////////////////////////
 //
 /**
@@ -47,6 +51,7 @@ MetadataList *mdListCreate() {
     MetadataList *list = malloc( sizeof( MetadataList ));
 
     list->first = NULL;
+    list->last = NULL;
     list->count = 0;
 
     return list;
@@ -88,21 +93,49 @@ MetadataNode *createMdNode( char command, char *operation, int value )
     node->command = command;
     copyString( node->operation, operation );
     node->value = value;
+    decodeMemValue( node );
 
     return node;
 }
 
+//==========================================================================
+/**
+* @brief Function splits an M op value into its segment, base and offset
+*
+* @details The value is written SSBBBOOO, eight digits with leading
+*   zeros, so the fields are read off with division and modulo. Values
+*   that are not an M op, or do not fit in eight digits, get a sid of -1
+*   so no memory op uses them.
+*
+* @param[in] node
+* A MetadataNode pointer whose command and value are set
+*/
+void decodeMemValue( MetadataNode *node )
+{
+    if( node->command != 'M' || node->value < 0 ||
+        node->value > MAX_MEM_VALUE )
+    {
+        node->sid = -1;
+        node->base = 0;
+        node->offset = 0;
+        return;
+    }
+
+    node->sid = node->value / 1000000;
+    node->base = node->value / 1000 % 1000;
+    node->offset = node->value % 1000;
+}
+
 //==========================================================================
 /**
 * @brief Function appends a node to the end of a list
 *
-* @details Function finds ending node in list and appends given node
+* @details Function links the given node after the list's last node
 *
 * @par Algorithm
-*   Function takes a node and a list, finds the ending node in the list,
-*   and links that last node to the given node, making the given node the
-*   new last node in the list. If the list is empty, it makes the given
-*   node the head of the list.
+*   Function takes a node and a list, links the list's last node to the
+*   given node, making the given node the new last node in the list.
+*   If the list is empty, it makes the given node the head of the list.
 *
 * @param[in] list
 * A metadataList pointer
@@ -115,18 +148,13 @@ void addMdNode( MetadataList *list, MetadataNode *node )
     if( list->first == NULL && list->count == 0 )
     {
         list->first = node;
+        list->last = node;
         list->count++;
         return;
     }
 
-    MetadataNode *currNode = list->first;
-
-    while( currNode->next != NULL )
-    {
-        currNode = currNode->next;
-    }
-
-    currNode->next = node;
+    list->last->next = node;
+    list->last = node;
     list->count++;
 
     return;
@@ -150,6 +178,11 @@ void addMdNode( MetadataList *list, MetadataNode *node )
 */
 static void freeMdNodes( MetadataList *list )
 {
+    if( list->first == NULL )
+    {
+        return;
+    }
+
     MetadataNode *next = list->first->next;
 
     while( next != NULL )
@@ -163,6 +196,7 @@ static void freeMdNodes( MetadataList *list )
     free( list->first );
 
     list->first = NULL;
+    list->last = NULL;
     list->count = 0;
 }
 
@@ -23,20 +23,32 @@ Secret Number: 764819
 //
 #include "utilities.h"
 //
+// Global Constant Definitions ////////////////////////////////////
+//
+extern const int MAX_MEM_VALUE;
+//
 // Data Structure Definitions (structs, enums, etc.)////////////////
 //
+/*
+  An M op's value SSBBBOOO is decoded once, into sid, base and offset.
+  Other ops, and M values with more than 8 digits, have a sid of -1.
+*/
 typedef struct MetadataNode
 {
     struct MetadataNode *next;
     char command;
     char *operation;
     int value;
+    int sid;
+    int base;
+    int offset;
 } MetadataNode;
 
 typedef struct MetadataList
 {
 	int count;
 	MetadataNode *first;
+	MetadataNode *last;
 } MetadataList;
 //
 // Free Function Prototypes ///////////////////////////////////////
@@ -54,7 +66,12 @@ MetadataList *mdListCreate();
 MetadataNode *createMdNode( char command, char *operation, int value );
 
 /*
-  Finds end of list and adds link to given node
+  Splits an M op value SSBBBOOO into its segment, base and offset.
+*/
+void decodeMemValue( MetadataNode *node );
+
+/*
+  Links given node after the last node in the list
 */
 void addMdNode( MetadataList *list, MetadataNode *node );
 
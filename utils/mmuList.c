@@ -19,15 +19,34 @@ then accessed later by the process operations.
 */
 // Header Files ///////////////////////////////////////////////////
 //
+#include <string.h>
 #include "mmuList.h"
 #include "configParser.h"
 //
 // Global Constant Definitions ////////////////////////////////////
 //
-///// NONE
+const int MIN_SID_SLOTS = 16;
+
+// one node per allocation, made and freed as processes run
+static ObjectPool nodePool = { sizeof( MMUNode ), PTHREAD_MUTEX_INITIALIZER };
 //
 // Free Function Prototypes ///////////////////////////////////////
 //
+static int allocsOverlap( int base, int offset, MMUNode *node );
+static MMUNode *findOverlap( MMUNode *root, int base, int offset );
+static int nodeHeight( MMUNode *node );
+static void updateNode( MMUNode *node );
+static MMUNode *rotateLeft( MMUNode *node );
+static MMUNode *rotateRight( MMUNode *node );
+static MMUNode *rebalance( MMUNode *node );
+static int compareAllocs( MMUNode *first, MMUNode *second );
+static MMUNode *treeInsert( MMUNode *root, MMUNode *node );
+static MMUNode *treeRemoveMin( MMUNode *root, MMUNode **minNode );
+static MMUNode *treeRemove( MMUNode *root, MMUNode *node );
+static int sidSlot( MMUList *list, int sid );
+static void growSidSlots( MMUList *list );
+static void sidRemove( MMUList *list, MMUNode *node );
+//
 //==========================================================================
 /**
 * @brief Function creates and returns a pointer to a linked list
@@ -51,9 +70,16 @@ MMUList *MMUListCreate( int totalMem ) {
     MMUList *list = malloc( sizeof( MMUList ));
 
     list->first = NULL;
+    list->last = NULL;
+    list->root = NULL;
+    list->sidCapacity = MIN_SID_SLOTS;
+    list->sidSlots = calloc( list->sidCapacity, sizeof( MMUNode * ) );
     list->count = 0;
     list->totalMemory = totalMem;
     list->availableMemory = totalMem;
+    list->paging = NULL;
+    list->buddy = NULL;
+    pthread_mutex_init( &list->lock, NULL );
 
     return list;
 }
@@ -64,12 +90,17 @@ MMUList *MMUListCreate( int totalMem ) {
 *
 * @details Function allocates space for a node in memory and creates
 *   a pointer to it, initializes the node fields to the given paramters,
-*   then returns the pointer to the node.
+*   then returns the pointer to the node. No node is made if the
+*   allocation falls outside memory, reuses a sid, or overlaps another.
+*   With the buddy allocator the offset is only a size, placed wherever
+*   the allocator has room, so allocations cannot overlap, but no node is
+*   made if there is no room.
 *
 * @par Algorithm
-*   Function takes in field parameters for an MMUNode, allocates space
-*   for and creates a pointer to the node, sets the fields to the values of
-*   the parameters and returns the pointer to the node.
+*   Function looks the sid up in the sid table and searches the interval
+*   tree for an overlapping allocation, or asks the buddy allocator for a
+*   block, then allocates space for the node and sets the fields to the
+*   values of the parameters.
 *
 * @param[in] sid
 * an integer representing an allocation ID
@@ -88,37 +119,44 @@ MMUList *MMUListCreate( int totalMem ) {
 MMUNode *createMMUNode( int pid, int sid, int base, int offset,
                         Config *configData, MMUList *mmu )
 {
-    if( base >= 0 && ( base + offset ) <= mmu->totalMemory )
+    int placed = base;
+    // a buddy allocation need only fit, it is not placed at its base
+    int end = mmu->buddy == NULL ? base + offset : offset;
+    // swapping pages lets allocations go past the end of memory
+    int limit = mmu->paging != NULL ? mmu->paging->virtualSize
+                                    : mmu->totalMemory;
+
+    if( base >= 0 && end <= limit )
     {
-        MMUNode *currNode = MMUListFirst( mmu );
-        while( currNode != NULL )
+        if( MMUFindSid( mmu, sid ) != NULL ||
+            ( mmu->buddy == NULL &&
+              findOverlap( mmu->root, base, offset ) != NULL ) )
         {
-            if( currNode->sid == sid )
-            {
-                return NULL;
-            }
+            return NULL;
+        }
 
-            else if(
-            ( base >= currNode->base &&
-                  base < ( currNode->base + currNode->offset ) ) ||
-            ( ( base + offset ) > currNode->base &&
-                ( base + offset ) <= ( currNode->base + currNode->offset ) ) ||
-            ( currNode->base >= base &&
-                currNode->base < ( base + offset ) ) ||
-            ( ( currNode->base + currNode->offset ) > base &&
-                ( currNode->base + currNode->offset ) <= ( base + offset ) ) )
+        if( mmu->buddy != NULL )
+        {
+            placed = buddyAlloc( mmu->buddy, offset );
+            if( placed < 0 )
             {
                 return NULL;
             }
-            currNode = currNode->next;
         }
 
-        MMUNode *node = malloc( sizeof( MMUNode ));
+        MMUNode *node = poolAlloc( &nodePool );
         node->next = NULL;
+        node->prev = NULL;
+        node->procNext = NULL;
+        node->left = NULL;
+        node->right = NULL;
+        node->height = 1;
+        node->maxEnd = base + offset;
         node->pid = pid;
         node->sid = sid;
         node->base = base;
         node->offset = offset;
+        node->placed = placed;
 
         return node;
     }
@@ -128,17 +166,562 @@ MMUNode *createMMUNode( int pid, int sid, int base, int offset,
     }
 }
 
+//==========================================================================
+/**
+* @brief Function returns whether an allocation overlaps a node
+*
+* @details The four tests are the ones allocations have always been
+*   checked with, so a zero length allocation is refused inside, or at
+*   either end of, another allocation, but two zero length allocations
+*   never overlap.
+*
+* @param[in] base
+* The base of the allocation
+*
+* @param[in] offset
+* The length of the allocation
+*
+* @param[in] node
+* An MMUNode pointer
+*
+* @return 1 if they overlap, 0 otherwise
+*/
+static int allocsOverlap( int base, int offset, MMUNode *node )
+{
+    return ( base >= node->base &&
+                base < ( node->base + node->offset ) ) ||
+           ( ( base + offset ) > node->base &&
+                ( base + offset ) <= ( node->base + node->offset ) ) ||
+           ( node->base >= base &&
+                node->base < ( base + offset ) ) ||
+           ( ( node->base + node->offset ) > base &&
+                ( node->base + node->offset ) <= ( base + offset ) );
+}
+
+//==========================================================================
+/**
+* @brief Function finds an allocation in a tree overlapping the given one
+*
+* @details Every overlap above needs node->base <= base + offset and
+*   node->base + node->offset >= base, so a subtree whose maxEnd is below
+*   base is skipped, and so is the right subtree of a node starting after
+*   base + offset.
+*
+* @param[in] root
+* The root of the tree or subtree to search
+*
+* @param[in] base
+* The base of the allocation
+*
+* @param[in] offset
+* The length of the allocation
+*
+* @return the overlapping node, or NULL if there is none
+*/
+static MMUNode *findOverlap( MMUNode *root, int base, int offset )
+{
+    MMUNode *found;
+
+    if( root == NULL || root->maxEnd < base )
+    {
+        return NULL;
+    }
+
+    found = findOverlap( root->left, base, offset );
+    if( found != NULL )
+    {
+        return found;
+    }
+
+    if( root->base > base + offset )
+    {
+        return NULL;
+    }
+    if( allocsOverlap( base, offset, root ) )
+    {
+        return root;
+    }
+    return findOverlap( root->right, base, offset );
+}
+
+//==========================================================================
+/**
+* @brief Function returns the height of a subtree, 0 if it is empty
+*
+* @param[in] node
+* An MMUNode pointer, may be NULL
+*
+* @return the height
+*/
+static int nodeHeight( MMUNode *node )
+{
+    return node != NULL ? node->height : 0;
+}
+
+//==========================================================================
+/**
+* @brief Function recomputes a node's height and maxEnd from its children
+*
+* @param[in] node
+* An MMUNode pointer
+*/
+static void updateNode( MMUNode *node )
+{
+    int leftHeight = nodeHeight( node->left );
+    int rightHeight = nodeHeight( node->right );
+
+    node->height = 1 + ( leftHeight > rightHeight ? leftHeight
+                                                  : rightHeight );
+    node->maxEnd = node->base + node->offset;
+    if( node->left != NULL && node->left->maxEnd > node->maxEnd )
+    {
+        node->maxEnd = node->left->maxEnd;
+    }
+    if( node->right != NULL && node->right->maxEnd > node->maxEnd )
+    {
+        node->maxEnd = node->right->maxEnd;
+    }
+}
+
+//==========================================================================
+/**
+* @brief Function rotates a subtree left
+*
+* @param[in] node
+* The root of the subtree, which has a right child
+*
+* @return the new root of the subtree
+*/
+static MMUNode *rotateLeft( MMUNode *node )
+{
+    MMUNode *newRoot = node->right;
+
+    node->right = newRoot->left;
+    newRoot->left = node;
+    updateNode( node );
+    updateNode( newRoot );
+
+    return newRoot;
+}
+
+//==========================================================================
+/**
+* @brief Function rotates a subtree right
+*
+* @param[in] node
+* The root of the subtree, which has a left child
+*
+* @return the new root of the subtree
+*/
+static MMUNode *rotateRight( MMUNode *node )
+{
+    MMUNode *newRoot = node->left;
+
+    node->left = newRoot->right;
+    newRoot->right = node;
+    updateNode( node );
+    updateNode( newRoot );
+
+    return newRoot;
+}
+
+//==========================================================================
+/**
+* @brief Function restores the AVL balance at a node
+*
+* @details Called on the way back up from an insert or remove, when the
+*   heights of the node's subtrees differ by at most two.
+*
+* @param[in] node
+* The root of the subtree
+*
+* @return the new root of the subtree
+*/
+static MMUNode *rebalance( MMUNode *node )
+{
+    int balance;
+
+    updateNode( node );
+    balance = nodeHeight( node->left ) - nodeHeight( node->right );
+
+    if( balance > 1 )
+    {
+        if( nodeHeight( node->left->left ) < nodeHeight( node->left->right ) )
+        {
+            node->left = rotateLeft( node->left );
+        }
+        return rotateRight( node );
+    }
+    if( balance < -1 )
+    {
+        if( nodeHeight( node->right->right ) <
+            nodeHeight( node->right->left ) )
+        {
+            node->right = rotateRight( node->right );
+        }
+        return rotateLeft( node );
+    }
+    return node;
+}
+
+//==========================================================================
+/**
+* @brief Function orders allocations by base, then by their unique sid
+*
+* @param[in] first
+* An MMUNode pointer
+*
+* @param[in] second
+* An MMUNode pointer
+*
+* @return negative if first comes before second, positive if after
+*/
+static int compareAllocs( MMUNode *first, MMUNode *second )
+{
+    if( first->base != second->base )
+    {
+        return first->base < second->base ? -1 : 1;
+    }
+    return first->sid < second->sid ? -1 : first->sid > second->sid;
+}
+
+//==========================================================================
+/**
+* @brief Function inserts a node into a tree
+*
+* @param[in] root
+* The root of the tree, may be NULL
+*
+* @param[in] node
+* The node to insert, with no children
+*
+* @return the new root of the tree
+*/
+static MMUNode *treeInsert( MMUNode *root, MMUNode *node )
+{
+    if( root == NULL )
+    {
+        return node;
+    }
+
+    if( compareAllocs( node, root ) < 0 )
+    {
+        root->left = treeInsert( root->left, node );
+    }
+    else
+    {
+        root->right = treeInsert( root->right, node );
+    }
+    return rebalance( root );
+}
+
+//==========================================================================
+/**
+* @brief Function removes the first node of a tree
+*
+* @param[in] root
+* The root of the tree, not NULL
+*
+* @param[out] minNode
+* Receives the removed node
+*
+* @return the new root of the tree
+*/
+static MMUNode *treeRemoveMin( MMUNode *root, MMUNode **minNode )
+{
+    if( root->left == NULL )
+    {
+        *minNode = root;
+        return root->right;
+    }
+
+    root->left = treeRemoveMin( root->left, minNode );
+    return rebalance( root );
+}
+
+//==========================================================================
+/**
+* @brief Function removes a node from a tree
+*
+* @details A node with two children is replaced by the first node of its
+*   right subtree.
+*
+* @param[in] root
+* The root of the tree, may be NULL
+*
+* @param[in] node
+* The node to remove
+*
+* @return the new root of the tree
+*/
+static MMUNode *treeRemove( MMUNode *root, MMUNode *node )
+{
+    MMUNode *successor;
+    MMUNode *newRight;
+    int order;
+
+    if( root == NULL )
+    {
+        return NULL;
+    }
+
+    order = compareAllocs( node, root );
+    if( order < 0 )
+    {
+        root->left = treeRemove( root->left, node );
+    }
+    else if( order > 0 )
+    {
+        root->right = treeRemove( root->right, node );
+    }
+    else
+    {
+        if( root->left == NULL || root->right == NULL )
+        {
+            return root->left != NULL ? root->left : root->right;
+        }
+
+        newRight = treeRemoveMin( root->right, &successor );
+        successor->right = newRight;
+        successor->left = root->left;
+        root = successor;
+    }
+    return rebalance( root );
+}
+
+//==========================================================================
+/**
+* @brief Function returns the slot holding a sid, or the empty slot it
+*   would go in
+*
+* @param[in] list
+* A MMUList pointer
+*
+* @param[in] sid
+* The sid to look for
+*
+* @return the slot index
+*/
+static int sidSlot( MMUList *list, int sid )
+{
+    int mask = list->sidCapacity - 1;
+    int slot = ( int )( ( ( unsigned int )sid * 2654435761u ) & mask );
+
+    while( list->sidSlots[ slot ] != NULL &&
+           list->sidSlots[ slot ]->sid != sid )
+    {
+        slot = ( slot + 1 ) & mask;
+    }
+    return slot;
+}
+
+//==========================================================================
+/**
+* @brief Function doubles the sid table and puts every allocation back
+*
+* @param[in] list
+* A MMUList pointer
+*/
+static void growSidSlots( MMUList *list )
+{
+    MMUNode *currNode;
+
+    free( list->sidSlots );
+    list->sidCapacity *= 2;
+    list->sidSlots = calloc( list->sidCapacity, sizeof( MMUNode * ) );
+
+    for( currNode = list->first; currNode != NULL; currNode = currNode->next )
+    {
+        list->sidSlots[ sidSlot( list, currNode->sid ) ] = currNode;
+    }
+}
+
+//==========================================================================
+/**
+* @brief Function takes an allocation out of the sid table
+*
+* @par Algorithm
+*   Function empties the node's slot, then moves back each following
+*   entry of the run whose home slot is not between the empty slot and
+*   it, so every entry stays reachable from its home slot.
+*
+* @param[in] list
+* A MMUList pointer
+*
+* @param[in] node
+* The allocation to take out
+*/
+static void sidRemove( MMUList *list, MMUNode *node )
+{
+    int mask = list->sidCapacity - 1;
+    int empty = sidSlot( list, node->sid );
+    int slot = empty;
+    int home;
+
+    if( list->sidSlots[ empty ] != node )
+    {
+        return;
+    }
+    list->sidSlots[ empty ] = NULL;
+
+    while( 1 )
+    {
+        slot = ( slot + 1 ) & mask;
+        if( list->sidSlots[ slot ] == NULL )
+        {
+            return;
+        }
+
+        home = ( int )( ( ( unsigned int )list->sidSlots[ slot ]->sid
+                          * 2654435761u ) & mask );
+        if( ( ( slot - home ) & mask ) >= ( ( slot - empty ) & mask ) )
+        {
+            list->sidSlots[ empty ] = list->sidSlots[ slot ];
+            list->sidSlots[ slot ] = NULL;
+            empty = slot;
+        }
+    }
+}
+
+//==========================================================================
+/**
+* @brief Function returns the allocation with the given sid
+*
+* @param[in] list
+* A MMUList pointer
+*
+* @param[in] sid
+* The sid to look for
+*
+* @return the allocation, or NULL if no allocation has that sid
+*/
+MMUNode *MMUFindSid( MMUList *list, int sid )
+{
+    return list->sidSlots[ sidSlot( list, sid ) ];
+}
+
+//==========================================================================
+/**
+* @brief Function returns the allocation a process made with a sid
+*
+* @details A sid is only ever allocated once at a time, by whichever
+*   process, so the sid table finds the one allocation it could be.
+*
+* @param[in] list
+* A MMUList pointer
+*
+* @param[in] pid
+* The process that made the allocation
+*
+* @param[in] sid
+* The sid to look for
+*
+* @return the allocation, or NULL if the process has none with that sid
+*/
+MMUNode *MMUFind( MMUList *list, int pid, int sid )
+{
+    MMUNode *node = MMUFindSid( list, sid );
+
+    return node != NULL && node->pid == pid ? node : NULL;
+}
+
+//==========================================================================
+/**
+* @brief Function adds a node to the front of a process's chain
+*
+* @param[in] chain
+* Points to the head of the chain, in the process's PCB
+*
+* @param[in] node
+* A MMUNode pointer, not yet in any chain
+*/
+void chainMMUNode( MMUNode **chain, MMUNode *node )
+{
+    node->procNext = *chain;
+    *chain = node;
+}
+
+//==========================================================================
+/**
+* @brief Function removes a node from the list and frees it
+*
+* @details Function unlinks the node from its neighbours in the list,
+*   takes it out of the interval tree and the sid table, and frees it.
+*   It is not taken out of its process's chain.
+*
+* @param[in] list
+* A MMUList pointer
+*
+* @param[in] node
+* A MMUNode pointer
+*/
+void removeMMUNode( MMUList *list, MMUNode *node )
+{
+    if( node->prev != NULL )
+    {
+        node->prev->next = node->next;
+    }
+    else
+    {
+        list->first = node->next;
+    }
+
+    if( node->next != NULL )
+    {
+        node->next->prev = node->prev;
+    }
+    else
+    {
+        list->last = node->prev;
+    }
+
+    list->root = treeRemove( list->root, node );
+    sidRemove( list, node );
+    if( list->buddy != NULL )
+    {
+        buddyFree( list->buddy, node->placed );
+    }
+    list->count--;
+    poolFree( &nodePool, node );
+}
+
+//==========================================================================
+/**
+* @brief Function removes and frees every node in a process's chain
+*
+* @details Only the process's own allocations are visited, so freeing k
+*   of them costs O( k log n ) however many other allocations are live.
+*
+* @param[in] list
+* A MMUList pointer
+*
+* @param[in] chain
+* Points to the head of the chain, left empty
+*/
+void freeMMUChain( MMUList *list, MMUNode **chain )
+{
+    MMUNode *node;
+
+    while( *chain != NULL )
+    {
+        node = *chain;
+        *chain = node->procNext;
+        removeMMUNode( list, node );
+    }
+}
+
 //==========================================================================
 /**
 * @brief Function appends a node to the end of a list
 *
-* @details Function finds ending node in list and appends given node
+* @details Function appends given node after the last node, and adds it
+*   to the interval tree and the sid table
 *
 * @par Algorithm
-*   Function takes a node and a list, finds the ending node in the list,
-*   and links that last node to the given node, making the given node the
-*   new last node in the list. If the list is empty, it makes the given
-*   node the head of the list.
+*   Function takes a node and a list and links the last node to the given
+*   node, making the given node the new last node in the list. If the
+*   list is empty, it makes the given node the head of the list. The sid
+*   table is doubled first if it would become over half full.
 *
 * @param[in] list
 * A MMUList pointer
@@ -148,21 +731,23 @@ MMUNode *createMMUNode( int pid, int sid, int base, int offset,
 */
 void addMMUNode( MMUList *list, MMUNode *node )
 {
+    if( 2 * ( list->count + 1 ) > list->sidCapacity )
+    {
+        growSidSlots( list );
+    }
+    list->sidSlots[ sidSlot( list, node->sid ) ] = node;
+    list->root = treeInsert( list->root, node );
+
+    node->prev = list->last;
     if( list->first == NULL && list->count == 0 )
     {
         list->first = node;
-        list->count++;
-        return;
     }
-
-    MMUNode *currNode = list->first;
-
-    while( currNode->next != NULL )
+    else
     {
-        currNode = currNode->next;
+        list->last->next = node;
     }
-
-    currNode->next = node;
+    list->last = node;
     list->count++;
 
     return;
@@ -195,14 +780,17 @@ static void freeMMUNodes( MMUList *list )
 
     while( next != NULL )
     {
-        free( list->first );
+        poolFree( &nodePool, list->first );
         list->first = next;
         next = next->next;
     }
-    free( list->first );
+    poolFree( &nodePool, list->first );
 
     list->first = NULL;
+    list->last = NULL;
+    list->root = NULL;
     list->count = 0;
+    memset( list->sidSlots, 0, sizeof( MMUNode * ) * list->sidCapacity );
 }
 
 //==========================================================================
@@ -224,6 +812,10 @@ static void freeMMUNodes( MMUList *list )
 MMUList *MMUListDestroy( MMUList *list )
 {
     freeMMUNodes( list );
+    free( list->sidSlots );
+    destroyPaging( list->paging );
+    destroyBuddyAllocator( list->buddy );
+    pthread_mutex_destroy( &list->lock );
     free( list );
 
     list = NULL;
@@ -20,29 +20,61 @@ Secret Number: 764819
 //
 // Header Files ///////////////////////////////////////////////////
 //
+#include <pthread.h>
 #include "configParser.h"
+#include "paging.h"
+#include "buddyAllocator.h"
+#include "objectPool.h"
 //
 // Global Constant Definitions ////////////////////////////////////
 //
-///// NONE
+extern const int MIN_SID_SLOTS;
 //
 // Data Structure Definitions (structs, enums, etc.)////////////////
 //
+/*
+  Every allocation is in the doubly linked list, in the order allocated,
+  in an AVL interval tree ordered by base, then sid, and in the chain of
+  its process's allocations, linked by procNext. height is the node's
+  height in the tree, maxEnd the largest base + offset under it. placed
+  is where the allocation is in memory, its base unless the buddy
+  allocator placed it, and accesses to it are moved there.
+*/
 typedef struct MMUNode
 {
     struct MMUNode *next;
+    struct MMUNode *prev;
+    struct MMUNode *procNext;
+    struct MMUNode *left;
+    struct MMUNode *right;
+    int height;
+    int maxEnd;
     int pid;
     int sid;
     int base;
     int offset;
+    int placed;
 } MMUNode;
 
+/*
+  root is the interval tree. sidSlots is an open addressing table of
+  sidCapacity slots, a power of two, finding the allocation with a sid.
+  paging is NULL unless accesses are translated through pages, buddy
+  NULL unless allocations are placed by the buddy allocator.
+*/
 typedef struct MMUList
 {
     MMUNode *first;
+    MMUNode *last;
+    MMUNode *root;
+    MMUNode **sidSlots;
+    int sidCapacity;
 	int count;
     int totalMemory;
     int availableMemory;
+    Paging *paging;
+    BuddyAllocator *buddy;
+    pthread_mutex_t lock;
 } MMUList;
 //
 // Free Function Prototypes ///////////////////////////////////////
@@ -66,6 +98,31 @@ MMUNode *createMMUNode( int pid, int sid, int base, int offset,
 */
 void addMMUNode( MMUList *list, MMUNode *node );
 
+/*
+  Adds a node to the front of a process's chain of allocations.
+*/
+void chainMMUNode( MMUNode **chain, MMUNode *node );
+
+/*
+  Takes a node out of the list, the tree and the sid table and frees it.
+*/
+void removeMMUNode( MMUList *list, MMUNode *node );
+
+/*
+  Removes and frees every node in a process's chain of allocations.
+*/
+void freeMMUChain( MMUList *list, MMUNode **chain );
+
+/*
+  Returns the allocation with the given sid, or NULL.
+*/
+MMUNode *MMUFindSid( MMUList *list, int sid );
+
+/*
+  Returns the allocation a process made with the given sid, or NULL.
+*/
+MMUNode *MMUFind( MMUList *list, int pid, int sid );
+
 /*
   Frees any nodes in the list and then frees the list structure.
 */
@@ -0,0 +1,374 @@
+// PROGRAMMER INFORMATION ////////////////////////////////////////////
+/**
+
+Secret Number: 764819
+
+*/
+// Code Implementation File Information /////////////////////////////
+/**
+* @file objectPool.c
+*
+* @brief Implementation file for objectPool code
+*
+* @details Implements all functions of the object pools
+*/
+// Program Description/Support /////////////////////////////////////
+/*
+Interrupts, I/O thread containers and allocation nodes are made and
+freed many times a run, by the dispatcher, the CPU threads and the I/O
+threads. A pool hands them out from slabs it keeps, and each thread
+works from its own cache of them, so most allocations and frees take no
+lock and make no call to malloc() or free(). An object may be freed by
+another thread than made it, it goes to that thread's cache. A thread's
+caches are given back to their pools when it exits.
+
+A thread that lives for one object, as an I/O thread does, would fill
+and flush a whole cache for it, so it gives the object straight back to
+the pool with poolFreeShared() and never makes caches at all.
+*/
+// Header Files ///////////////////////////////////////////////////
+//
+#include "objectPool.h"
+//
+// Global Constant Definitions ////////////////////////////////////
+//
+const int POOL_SLAB_OBJECTS = 64;
+const int POOL_CACHE_OBJECTS = 32;
+const int MAX_THREAD_POOLS = 8;
+// objects are placed as malloc() would place them
+const int POOL_ALIGNMENT = 16;
+
+// each thread's array of caches, made on its first use of a pool
+static pthread_key_t cacheKey;
+static pthread_once_t cacheKeyOnce = PTHREAD_ONCE_INIT;
+//
+// Free Function Prototypes ///////////////////////////////////////
+//
+static void makeCacheKey( void );
+static void flushThreadCaches( void *caches );
+static PoolCache *findCache( ObjectPool *pool );
+static void addSlab( ObjectPool *pool );
+static void fillCache( ObjectPool *pool, PoolCache *cache, int count );
+static void returnObjects( ObjectPool *pool, PoolCache *cache, int keep );
+//
+//==========================================================================
+/**
+* @brief Function takes an object from a pool
+*
+* @details The object's contents are left as they were, the caller
+*   sets every field.
+*
+* @par Algorithm
+*   Function pops the object from the thread's cache for the pool,
+*   filling an empty cache with half as many objects as it holds from
+*   the pool's free list first. A thread with no room for another cache
+*   pops straight from the free list, under the lock.
+*
+* @param[in] pool
+* A pointer to the ObjectPool
+*
+* @return a pointer to the object
+*/
+void *poolAlloc( ObjectPool *pool )
+{
+    PoolCache *cache = findCache( pool );
+    PoolCache single = { NULL, NULL, 0 };
+    void *object;
+
+    if( cache == NULL )
+    {
+        cache = &single;
+    }
+
+    if( cache->count == 0 )
+    {
+        fillCache( pool, cache, cache == &single ? 1
+                                                 : POOL_CACHE_OBJECTS / 2 );
+    }
+
+    // a free object holds the next free object in its first bytes
+    object = cache->head;
+    cache->head = *( void ** )object;
+    cache->count--;
+
+    return object;
+}
+
+//==========================================================================
+/**
+* @brief Function gives an object back to its pool
+*
+* @par Algorithm
+*   Function pushes the object onto the thread's cache for the pool.
+*   Once the cache holds more than POOL_CACHE_OBJECTS, all but the half
+*   freed last are given to the pool's free list. A thread with no room
+*   for another cache gives it straight to the free list.
+*
+* @param[in] pool
+* A pointer to the ObjectPool the object was taken from
+*
+* @param[in] object
+* A pointer to the object
+*/
+void poolFree( ObjectPool *pool, void *object )
+{
+    PoolCache *cache = findCache( pool );
+    PoolCache single = { NULL, NULL, 0 };
+
+    if( cache == NULL )
+    {
+        cache = &single;
+    }
+
+    *( void ** )object = cache->head;
+    cache->head = object;
+    cache->count++;
+
+    if( cache == &single )
+    {
+        returnObjects( pool, cache, 0 );
+    }
+    else if( cache->count > POOL_CACHE_OBJECTS )
+    {
+        returnObjects( pool, cache, POOL_CACHE_OBJECTS / 2 );
+    }
+}
+
+//==========================================================================
+/**
+* @brief Function gives an object back to its pool without using the
+*   calling thread's caches
+*
+* @details For threads that free an object or two and exit, which would
+*   otherwise make caches only to flush them.
+*
+* @param[in] pool
+* A pointer to the ObjectPool the object was taken from
+*
+* @param[in] object
+* A pointer to the object
+*/
+void poolFreeShared( ObjectPool *pool, void *object )
+{
+    pthread_mutex_lock( &pool->lock );
+    *( void ** )object = pool->freeList;
+    pool->freeList = object;
+    pool->freeCount++;
+    pthread_mutex_unlock( &pool->lock );
+}
+
+//==========================================================================
+/**
+* @brief Function makes the key each thread's caches are found by
+*/
+static void makeCacheKey( void )
+{
+    pthread_key_create( &cacheKey, flushThreadCaches );
+}
+
+//==========================================================================
+/**
+* @brief Function gives every object in an exiting thread's caches back
+*   to its pool
+*
+* @param[in] caches
+* The thread's array of MAX_THREAD_POOLS PoolCache structs
+*/
+static void flushThreadCaches( void *caches )
+{
+    PoolCache *cache = ( PoolCache * )caches;
+    int index;
+
+    for( index = 0; index < MAX_THREAD_POOLS &&
+                    cache[ index ].pool != NULL; index++ )
+    {
+        returnObjects( cache[ index ].pool, &cache[ index ], 0 );
+    }
+    free( caches );
+}
+
+//==========================================================================
+/**
+* @brief Function finds the calling thread's cache for a pool
+*
+* @details A thread's caches are made the first time it uses any pool.
+*   If they cannot be made the thread works from the shared lists.
+*
+* @param[in] pool
+* A pointer to the ObjectPool
+*
+* @return a pointer to the cache, or NULL if the thread has no room for
+*   another or no caches
+*/
+static PoolCache *findCache( ObjectPool *pool )
+{
+    PoolCache *caches;
+    int index;
+
+    pthread_once( &cacheKeyOnce, makeCacheKey );
+    caches = pthread_getspecific( cacheKey );
+    if( caches == NULL )
+    {
+        caches = calloc( MAX_THREAD_POOLS, sizeof( PoolCache ) );
+        if( caches == NULL )
+        {
+            return NULL;
+        }
+        pthread_setspecific( cacheKey, caches );
+    }
+
+    for( index = 0; index < MAX_THREAD_POOLS; index++ )
+    {
+        if( caches[ index ].pool == NULL )
+        {
+            caches[ index ].pool = pool;
+        }
+        if( caches[ index ].pool == pool )
+        {
+            return &caches[ index ];
+        }
+    }
+    return NULL;
+}
+
+//==========================================================================
+/**
+* @brief Function carves a new slab into the pool's free list
+*
+* @details The pool's lock is held by the caller.
+*
+* @par Algorithm
+*   Function rounds the object size up to POOL_ALIGNMENT and allocates
+*   room for one more object than a slab holds, the first place linking
+*   the slab to the pool's other slabs. The objects are pushed from the
+*   last, so they are handed out in address order.
+*
+* @param[in] pool
+* A pointer to the ObjectPool
+*/
+static void addSlab( ObjectPool *pool )
+{
+    int stride = ( pool->objectSize + POOL_ALIGNMENT - 1 )
+                 / POOL_ALIGNMENT * POOL_ALIGNMENT;
+    char *slab = malloc( ( size_t )stride * ( POOL_SLAB_OBJECTS + 1 ) );
+    int index;
+
+    *( void ** )slab = pool->slabs;
+    pool->slabs = slab;
+    pool->slabCount++;
+
+    for( index = POOL_SLAB_OBJECTS; index >= 1; index-- )
+    {
+        *( void ** )( slab + index * stride ) = pool->freeList;
+        pool->freeList = slab + index * stride;
+    }
+    pool->freeCount += POOL_SLAB_OBJECTS;
+}
+
+//==========================================================================
+/**
+* @brief Function moves objects from the pool's free list to an empty
+*   cache
+*
+* @details A slab is added first if the free list is too short.
+*
+* @param[in] pool
+* A pointer to the ObjectPool
+*
+* @param[in] cache
+* A pointer to the empty PoolCache
+*
+* @param[in] count
+* The number of objects to move, at most POOL_SLAB_OBJECTS
+*/
+static void fillCache( ObjectPool *pool, PoolCache *cache, int count )
+{
+    void *last;
+    int index;
+
+    pthread_mutex_lock( &pool->lock );
+
+    if( pool->freeCount < count )
+    {
+        addSlab( pool );
+    }
+
+    cache->head = pool->freeList;
+    last = cache->head;
+    for( index = 1; index < count; index++ )
+    {
+        last = *( void ** )last;
+    }
+    pool->freeList = *( void ** )last;
+    pool->freeCount -= count;
+    *( void ** )last = NULL;
+    cache->count = count;
+
+    pthread_mutex_unlock( &pool->lock );
+}
+
+//==========================================================================
+/**
+* @brief Function gives all but the first objects of a cache to the
+*   pool's free list
+*
+* @par Algorithm
+*   Function walks past the objects kept and on to the end of the cache,
+*   then splices the objects after those kept onto the free list under
+*   the pool's lock.
+*
+* @param[in] pool
+* A pointer to the ObjectPool
+*
+* @param[in] cache
+* A pointer to the PoolCache
+*
+* @param[in] keep
+* The number of objects to keep, the most recently freed
+*/
+static void returnObjects( ObjectPool *pool, PoolCache *cache, int keep )
+{
+    void *kept = NULL;
+    void *first = cache->head;
+    void *last;
+    int index;
+
+    if( cache->count <= keep )
+    {
+        return;
+    }
+
+    for( index = 0; index < keep; index++ )
+    {
+        kept = first;
+        first = *( void ** )first;
+    }
+    last = first;
+    while( *( void ** )last != NULL )
+    {
+        last = *( void ** )last;
+    }
+
+    if( kept != NULL )
+    {
+        *( void ** )kept = NULL;
+    }
+    else
+    {
+        cache->head = NULL;
+    }
+
+    pthread_mutex_lock( &pool->lock );
+    *( void ** )last = pool->freeList;
+    pool->freeList = first;
+    pool->freeCount += cache->count - keep;
+    pthread_mutex_unlock( &pool->lock );
+
+    cache->count = keep;
+}
+
+//==========================================================================
+// Terminating Precompiler Directives ///////////////////////////////
+//
+///// NONE
+//
@@ -0,0 +1,84 @@
+// PROGRAMMER INFORMATION ////////////////////////////////////////////
+/**
+
+Secret Number: 764819
+
+*/
+// Header File Information /////////////////////////////////////
+/**
+* @file objectPool.h
+*
+* @brief Header file for objectPool code
+*
+* @details Specifies functions, constants, and other information
+* related to handing out small objects of one size from shared pools
+*/
+// Precompiler Directives //////////////////////////////////////////
+//
+#ifndef OBJECT_POOL_H
+#define OBJECT_POOL_H
+//
+// Header Files ///////////////////////////////////////////////////
+//
+#include <pthread.h>
+#include <stdlib.h>
+//
+// Global Constant Definitions ////////////////////////////////////
+//
+extern const int POOL_SLAB_OBJECTS;
+extern const int POOL_CACHE_OBJECTS;
+extern const int MAX_THREAD_POOLS;
+//
+// Data Structure Definitions (structs, enums, etc.)////////////////
+//
+/*
+  A pool of objects of objectSize bytes, carved POOL_SLAB_OBJECTS at a
+  time from slabs that are kept for the life of the program, linked from
+  slabs. Objects given back are on freeList, freeCount long, linked
+  through their first bytes.
+
+  Each thread keeps a cache of objects of its own for each pool it uses,
+  so it takes the lock only to fill an empty cache or to give half of a
+  full one back. A pool is defined static where its objects are made,
+  as { sizeof( Type ), PTHREAD_MUTEX_INITIALIZER }, the rest left zero.
+*/
+typedef struct ObjectPool
+{
+    int objectSize;
+    pthread_mutex_t lock;
+    void *freeList;
+    int freeCount;
+    void *slabs;
+    long slabCount;
+} ObjectPool;
+
+/*
+  A thread's cache for one pool, count objects linked from head. A
+  thread has room for caches of MAX_THREAD_POOLS pools, any other pool
+  it uses goes to the shared list every time.
+*/
+typedef struct PoolCache
+{
+    ObjectPool *pool;
+    void *head;
+    int count;
+} PoolCache;
+//
+// Free Function Prototypes ///////////////////////////////////////
+//
+//==========================================================================
+
+void *poolAlloc( ObjectPool *pool );
+
+//==========================================================================
+
+void poolFree( ObjectPool *pool, void *object );
+
+//==========================================================================
+
+void poolFreeShared( ObjectPool *pool, void *object );
+
+// Terminating Precompiler Directives ///////////////////////////////
+//
+#endif // OBJECT_POOL_H
+//
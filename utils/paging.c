@@ -0,0 +1,540 @@
+// PROGRAMMER INFORMATION ////////////////////////////////////////////
+/**
+
+Secret Number: 764819
+
+*/
+// Code Implementation File Information /////////////////////////////
+/**
+* @file paging.c
+*
+* @brief Implementation file for paging code
+*
+* @details Implements all functions of the paging unit
+*/
+// Program Description/Support /////////////////////////////////////
+/*
+With a page size configured, an access is translated a page at a time.
+The TLB is looked at first, and on a miss the process's page table. A
+page not yet in a frame faults and is given a free one. A process's
+page table is made on its first miss, so a process that never accesses
+memory has none, and its frames go back on the free stack when it ends.
+
+With a swap file configured, a fault with no frame free evicts a page
+chosen by the clock algorithm: the hand passes over frames used since it
+last passed, clearing their referenced bits, and evicts the first that
+was not used. The evicted page is written to a slot of the swap file,
+and read back when it faults again. Memory can then be overcommitted,
+allocations reaching as far as an op can name rather than only to the
+end of memory.
+*/
+// Header Files ///////////////////////////////////////////////////
+//
+#include "paging.h"
+//
+// Global Constant Definitions ////////////////////////////////////
+//
+const int NO_FRAME = -1;
+// bytes moved to or from the swap file per KB of a page
+const int SWAP_BLOCK_SIZE = 1024;
+// the furthest an SS/BBB/OOO value reaches, BBB + OOO
+const int MAX_VIRTUAL_KB = 1998;
+//
+// Free Function Prototypes ///////////////////////////////////////
+//
+static TLBEntry *findTLBVictim( TLBEntry *set, int ways );
+static int takeFrame( Paging *paging, int *swapped );
+static int evictPage( Paging *paging );
+static void dropTLBEntry( Paging *paging, int pid, int page );
+static int takeSwapSlot( Paging *paging );
+static void moveSwapBlock( Paging *paging, int slot, int writing );
+//
+//==========================================================================
+/**
+* @brief Function creates the paging unit for a memory of the given size
+*
+* @details No unit is needed if no page size is configured. The TLB has
+*   the configured number of entries in sets of the configured ways,
+*   ways beyond the entries are not kept. Pages are only swapped if a
+*   swap file is configured and can be opened, the caller logging it if
+*   it cannot.
+*
+* @param[in] totalMem
+* The size of memory in KB
+*
+* @param[in] configData
+* A pointer to the Config struct holding the page size, TLB shape and
+*   swap file
+*
+* @return a pointer to the paging unit, or NULL if paging is off
+*/
+Paging *createPaging( int totalMem, Config *configData )
+{
+    Paging *paging;
+    int frame;
+
+    if( configData->pageSize <= 0 )
+    {
+        return NULL;
+    }
+
+    paging = malloc( sizeof( Paging ) );
+    paging->pageSize = configData->pageSize;
+    paging->numFrames = totalMem / paging->pageSize;
+    paging->swapFile = NULL;
+    copyString( paging->swapFilePath, configData->swapFilePath );
+    if( paging->swapFilePath[ 0 ] != NUL )
+    {
+        paging->swapFile = fopen( paging->swapFilePath, "w+b" );
+    }
+    paging->virtualSize = paging->swapFile != NULL &&
+                          totalMem < MAX_VIRTUAL_KB ? MAX_VIRTUAL_KB
+                                                    : totalMem;
+    paging->numPages = ( paging->virtualSize + paging->pageSize - 1 )
+                       / paging->pageSize;
+
+    // frame 0 is handed out first
+    paging->freeFrames = malloc( sizeof( int ) * ( paging->numFrames + 1 ) );
+    for( frame = 0; frame < paging->numFrames; frame++ )
+    {
+        paging->freeFrames[ frame ] = paging->numFrames - 1 - frame;
+    }
+    paging->freeCount = paging->numFrames;
+    paging->frameTables = calloc( paging->numFrames + 1, sizeof( int * ) );
+    paging->framePids = malloc( sizeof( int ) * ( paging->numFrames + 1 ) );
+    paging->framePages = malloc( sizeof( int ) * ( paging->numFrames + 1 ) );
+    paging->referenced = calloc( paging->numFrames + 1, sizeof( char ) );
+    paging->clockHand = 0;
+
+    paging->tlbWays = configData->tlbWays < configData->tlbEntries ?
+                      configData->tlbWays : configData->tlbEntries;
+    paging->tlbSets = configData->tlbEntries / paging->tlbWays;
+    paging->tlb = calloc( paging->tlbSets * paging->tlbWays,
+                          sizeof( TLBEntry ) );
+
+    paging->swapBlock = calloc( SWAP_BLOCK_SIZE, sizeof( char ) );
+    paging->slotCapacity = 64;
+    paging->freeSlots = malloc( sizeof( int ) * paging->slotCapacity );
+    paging->freeSlotCount = 0;
+    paging->slotCount = 0;
+
+    paging->lookups = 0;
+    paging->tlbHits = 0;
+    paging->tlbMisses = 0;
+    paging->pageFaults = 0;
+    paging->swapIns = 0;
+    paging->swapOuts = 0;
+    paging->swapErrors = 0;
+
+    return paging;
+}
+
+//==========================================================================
+/**
+* @brief Function frees the paging unit
+*
+* @details The swap file is closed and removed, nothing in it being of
+*   use once the run is over.
+*
+* @param[in] paging
+* A Paging pointer, may be NULL
+*
+* @return NULL
+*/
+Paging *destroyPaging( Paging *paging )
+{
+    if( paging != NULL )
+    {
+        if( paging->swapFile != NULL )
+        {
+            fclose( paging->swapFile );
+            remove( paging->swapFilePath );
+        }
+        free( paging->freeFrames );
+        free( paging->frameTables );
+        free( paging->framePids );
+        free( paging->framePages );
+        free( paging->referenced );
+        free( paging->tlb );
+        free( paging->swapBlock );
+        free( paging->freeSlots );
+        free( paging );
+    }
+    return NULL;
+}
+
+//==========================================================================
+/**
+* @brief Function finds the frame a process's page is in
+*
+* @details A TLB hit answers at once. On a miss the page table is read,
+*   and a page in no frame faults and is given a frame, a swapped page
+*   being read back into it. Either way the translation then replaces
+*   the least recently used entry of the page's TLB set. The frame is
+*   marked referenced for the clock hand.
+*
+* @par Algorithm
+* Function counts the lookup, searches the ways of set page % tlbSets for
+*   the pid and page. On a miss the page table is made if the process has
+*   none, a page with no frame takes a free one or evicts a page, has its
+*   slot read if it was swapped out, and is recorded as the frame's owner.
+*   An empty or the least recently used way is overwritten with the
+*   translation.
+*
+* @param[in] paging
+* A pointer to the paging unit
+*
+* @param[in] pid
+* The process the page belongs to
+*
+* @param[in] pageTable
+* A pointer to the process's page table, which may still be NULL
+*
+* @param[in] page
+* The page number, below numPages
+*
+* @param[out] faulted
+* Set to 1 if the page had to be given a frame, left as is otherwise
+*
+* @param[out] swapped
+* Increased by the number of pages written to or read from the swap file
+*
+* @return the frame the page is in, or NO_FRAME if it faulted and no
+*   frame could be freed for it
+*/
+int translatePage( Paging *paging, int pid, int **pageTable, int page,
+                   int *faulted, int *swapped )
+{
+    TLBEntry *set = &paging->tlb[ ( page % paging->tlbSets )
+                                  * paging->tlbWays ];
+    TLBEntry *entry;
+    int frame;
+    int index;
+    int way;
+
+    paging->lookups++;
+    for( way = 0; way < paging->tlbWays; way++ )
+    {
+        entry = &set[ way ];
+        if( entry->valid && entry->pid == pid && entry->page == page )
+        {
+            paging->tlbHits++;
+            entry->lastUsed = paging->lookups;
+            paging->referenced[ entry->frame ] = 1;
+            return entry->frame;
+        }
+    }
+    paging->tlbMisses++;
+
+    if( *pageTable == NULL )
+    {
+        *pageTable = malloc( sizeof( int ) * paging->numPages );
+        for( index = 0; index < paging->numPages; index++ )
+        {
+            ( *pageTable )[ index ] = NO_FRAME;
+        }
+    }
+
+    frame = ( *pageTable )[ page ];
+    if( frame < 0 )
+    {
+        frame = takeFrame( paging, swapped );
+        if( frame == NO_FRAME )
+        {
+            return NO_FRAME;
+        }
+
+        // a swapped page is read back from its slot, which is then free
+        if( ( *pageTable )[ page ] != NO_FRAME )
+        {
+            moveSwapBlock( paging, -2 - ( *pageTable )[ page ], 0 );
+            paging->freeSlots[ paging->freeSlotCount ] =
+                -2 - ( *pageTable )[ page ];
+            paging->freeSlotCount++;
+            paging->swapIns++;
+            ( *swapped )++;
+        }
+
+        ( *pageTable )[ page ] = frame;
+        paging->frameTables[ frame ] = *pageTable;
+        paging->framePids[ frame ] = pid;
+        paging->framePages[ frame ] = page;
+        paging->pageFaults++;
+        *faulted = 1;
+    }
+    paging->referenced[ frame ] = 1;
+
+    entry = findTLBVictim( set, paging->tlbWays );
+    entry->valid = 1;
+    entry->pid = pid;
+    entry->page = page;
+    entry->frame = frame;
+    entry->lastUsed = paging->lookups;
+
+    return frame;
+}
+
+//==========================================================================
+/**
+* @brief Function picks the TLB way a new translation goes in
+*
+* @param[in] set
+* A pointer to the first way of the set
+*
+* @param[in] ways
+* The number of ways in the set
+*
+* @return the first empty way, or the least recently used if none is
+*/
+static TLBEntry *findTLBVictim( TLBEntry *set, int ways )
+{
+    TLBEntry *victim = &set[ 0 ];
+    int way;
+
+    for( way = 0; way < ways; way++ )
+    {
+        if( !set[ way ].valid )
+        {
+            return &set[ way ];
+        }
+        if( set[ way ].lastUsed < victim->lastUsed )
+        {
+            victim = &set[ way ];
+        }
+    }
+    return victim;
+}
+
+//==========================================================================
+/**
+* @brief Function takes a frame for a page that faulted
+*
+* @param[in] paging
+* A pointer to the paging unit
+*
+* @param[out] swapped
+* Increased by one if a page had to be swapped out for the frame
+*
+* @return a free frame, the frame of an evicted page if none is free, or
+*   NO_FRAME if there is no swap file to evict to
+*/
+static int takeFrame( Paging *paging, int *swapped )
+{
+    if( paging->freeCount > 0 )
+    {
+        paging->freeCount--;
+        return paging->freeFrames[ paging->freeCount ];
+    }
+
+    if( paging->swapFile == NULL || paging->numFrames == 0 )
+    {
+        return NO_FRAME;
+    }
+
+    ( *swapped )++;
+    return evictPage( paging );
+}
+
+//==========================================================================
+/**
+* @brief Function swaps out the page the clock hand picks
+*
+* @par Algorithm
+* Function moves the hand on past every frame marked referenced,
+*   clearing the mark, and stops at the first frame not marked. That
+*   frame's page is written to a swap slot, its owner's page table entry
+*   set to the slot and its TLB entry dropped, and the hand moves past it.
+*
+* @param[in] paging
+* A pointer to the paging unit, with every frame in use
+*
+* @return the frame freed
+*/
+static int evictPage( Paging *paging )
+{
+    int frame;
+    int slot;
+
+    while( paging->referenced[ paging->clockHand ] )
+    {
+        paging->referenced[ paging->clockHand ] = 0;
+        paging->clockHand = ( paging->clockHand + 1 ) % paging->numFrames;
+    }
+    frame = paging->clockHand;
+    paging->clockHand = ( paging->clockHand + 1 ) % paging->numFrames;
+
+    slot = takeSwapSlot( paging );
+    moveSwapBlock( paging, slot, 1 );
+    paging->frameTables[ frame ][ paging->framePages[ frame ] ] = -2 - slot;
+    dropTLBEntry( paging, paging->framePids[ frame ],
+                  paging->framePages[ frame ] );
+    paging->swapOuts++;
+
+    return frame;
+}
+
+//==========================================================================
+/**
+* @brief Function drops the TLB entry for a page, if there is one
+*
+* @param[in] paging
+* A pointer to the paging unit
+*
+* @param[in] pid
+* The process the page belongs to
+*
+* @param[in] page
+* The page number
+*/
+static void dropTLBEntry( Paging *paging, int pid, int page )
+{
+    TLBEntry *set = &paging->tlb[ ( page % paging->tlbSets )
+                                  * paging->tlbWays ];
+    int way;
+
+    for( way = 0; way < paging->tlbWays; way++ )
+    {
+        if( set[ way ].pid == pid && set[ way ].page == page )
+        {
+            set[ way ].valid = 0;
+        }
+    }
+}
+
+//==========================================================================
+/**
+* @brief Function takes a free swap slot, or a new one past the last
+*
+* @param[in] paging
+* A pointer to the paging unit
+*
+* @return the slot number
+*/
+static int takeSwapSlot( Paging *paging )
+{
+    if( paging->freeSlotCount > 0 )
+    {
+        paging->freeSlotCount--;
+        return paging->freeSlots[ paging->freeSlotCount ];
+    }
+
+    // every used slot may be freed, so the stack has room for them all
+    if( paging->slotCount == paging->slotCapacity )
+    {
+        paging->slotCapacity *= 2;
+        paging->freeSlots = realloc( paging->freeSlots,
+                                     sizeof( int ) * paging->slotCapacity );
+    }
+    paging->slotCount++;
+    return paging->slotCount - 1;
+}
+
+//==========================================================================
+/**
+* @brief Function writes a page to its swap slot or reads it back
+*
+* @details The simulator keeps no page contents, so a page's worth of
+*   bytes is moved, a KB at a time, for the I/O to be real. A failed seek,
+*   write or read, a full disk say, is counted in swapErrors and the page
+*   is still taken as moved, there being nothing in it to lose.
+*
+* @param[in] paging
+* A pointer to the paging unit
+*
+* @param[in] slot
+* The slot, at slot pages into the file
+*
+* @param[in] writing
+* Nonzero to write the slot, zero to read it
+*/
+static void moveSwapBlock( Paging *paging, int slot, int writing )
+{
+    size_t moved = SWAP_BLOCK_SIZE;
+    int kb;
+
+    if( fseek( paging->swapFile,
+               ( long )slot * paging->pageSize * SWAP_BLOCK_SIZE,
+               SEEK_SET ) != 0 )
+    {
+        paging->swapErrors++;
+        return;
+    }
+
+    for( kb = 0; kb < paging->pageSize &&
+                 moved == ( size_t )SWAP_BLOCK_SIZE; kb++ )
+    {
+        moved = writing ? fwrite( paging->swapBlock, 1, SWAP_BLOCK_SIZE,
+                                  paging->swapFile )
+                        : fread( paging->swapBlock, 1, SWAP_BLOCK_SIZE,
+                                 paging->swapFile );
+    }
+
+    // buffered writes fail when flushed, so a write is pushed out here
+    if( moved != ( size_t )SWAP_BLOCK_SIZE ||
+        ( writing && fflush( paging->swapFile ) != 0 ) )
+    {
+        paging->swapErrors++;
+        clearerr( paging->swapFile );
+    }
+}
+
+//==========================================================================
+/**
+* @brief Function frees a process's frames, swap slots and page table
+*
+* @details The process's TLB entries are dropped too, so a later process
+*   given the same pid does not find them.
+*
+* @param[in] paging
+* A pointer to the paging unit
+*
+* @param[in] pid
+* The process the page table belongs to
+*
+* @param[in] pageTable
+* A pointer to the process's page table, set to NULL, may hold NULL
+*/
+void freePageTable( Paging *paging, int pid, int **pageTable )
+{
+    int index;
+    int frame;
+
+    if( *pageTable == NULL )
+    {
+        return;
+    }
+
+    for( index = 0; index < paging->numPages; index++ )
+    {
+        frame = ( *pageTable )[ index ];
+        if( frame >= 0 )
+        {
+            paging->frameTables[ frame ] = NULL;
+            paging->referenced[ frame ] = 0;
+            paging->freeFrames[ paging->freeCount ] = frame;
+            paging->freeCount++;
+        }
+        else if( frame != NO_FRAME )
+        {
+            paging->freeSlots[ paging->freeSlotCount ] = -2 - frame;
+            paging->freeSlotCount++;
+        }
+    }
+
+    for( index = 0; index < paging->tlbSets * paging->tlbWays; index++ )
+    {
+        if( paging->tlb[ index ].pid == pid )
+        {
+            paging->tlb[ index ].valid = 0;
+        }
+    }
+
+    free( *pageTable );
+    *pageTable = NULL;
+}
+
+//==========================================================================
+// Terminating Precompiler Directives ///////////////////////////////
+//
+///// NONE
+//
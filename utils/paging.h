@@ -0,0 +1,119 @@
+// PROGRAMMER INFORMATION ////////////////////////////////////////////
+/**
+
+Secret Number: 764819
+
+*/
+// Header File Information /////////////////////////////////////
+/**
+* @file paging.h
+*
+* @brief Header file for paging code
+*
+* @details Specifies functions, constants, and other information
+* related to translating memory accesses through page tables and a TLB,
+* and to swapping pages out to a file when memory is full
+*/
+// Precompiler Directives //////////////////////////////////////////
+//
+#ifndef PAGING_H
+#define PAGING_H
+//
+// Header Files ///////////////////////////////////////////////////
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include "configParser.h"
+#include "utilities.h"
+//
+// Global Constant Definitions ////////////////////////////////////
+//
+extern const int NO_FRAME;
+extern const int SWAP_BLOCK_SIZE;
+extern const int MAX_VIRTUAL_KB;
+//
+// Data Structure Definitions (structs, enums, etc.)////////////////
+//
+/*
+  One TLB entry, tagged with the pid it translates for so a switch to
+  another process need not flush the TLB. lastUsed is the lookup count
+  at its last hit, the least recently used way of a set has the lowest.
+*/
+typedef struct TLBEntry
+{
+    int valid;
+    int pid;
+    int page;
+    int frame;
+    long lastUsed;
+} TLBEntry;
+
+/*
+  Allocations may reach up to virtualSize KB, split into numPages pages,
+  and memory is split into numFrames frames of pageSize KB. Free frames are
+  a stack of freeCount frame numbers. The TLB is tlbSets sets of tlbWays
+  entries, a page always going in set page % tlbSets.
+
+  A page table entry is the page's frame, NO_FRAME if the page was never
+  used, or -2 - slot if it is swapped out to that slot of swapFile. Each
+  frame in use has the page table, pid and page of its owner, and the
+  referenced bit the clock hand clears as it looks for a page to evict.
+  Freed slots are a stack of freeSlotCount in room for slotCapacity,
+  slotCount slots have been used. swapBlock holds a KB being moved.
+  swapErrors counts the pages the swap file failed to take or give back.
+*/
+typedef struct Paging
+{
+    int pageSize;
+    int virtualSize;
+    int numPages;
+    int numFrames;
+    int *freeFrames;
+    int freeCount;
+    int **frameTables;
+    int *framePids;
+    int *framePages;
+    char *referenced;
+    int clockHand;
+    TLBEntry *tlb;
+    int tlbSets;
+    int tlbWays;
+    FILE *swapFile;
+    char swapFilePath[ 50 ];
+    char *swapBlock;
+    int *freeSlots;
+    int freeSlotCount;
+    int slotCapacity;
+    int slotCount;
+    long lookups;
+    long tlbHits;
+    long tlbMisses;
+    long pageFaults;
+    long swapIns;
+    long swapOuts;
+    long swapErrors;
+} Paging;
+//
+// Free Function Prototypes ///////////////////////////////////////
+//
+//==========================================================================
+
+Paging *createPaging( int totalMem, Config *configData );
+
+//==========================================================================
+
+Paging *destroyPaging( Paging *paging );
+
+//==========================================================================
+
+int translatePage( Paging *paging, int pid, int **pageTable, int page,
+                   int *faulted, int *swapped );
+
+//==========================================================================
+
+void freePageTable( Paging *paging, int pid, int **pageTable );
+
+// Terminating Precompiler Directives ///////////////////////////////
+//
+#endif // PAGING_H
+//
@@ -0,0 +1,350 @@
+// PROGRAMMER INFORMATION ////////////////////////////////////////////
+/**
+
+Secret Number: 764819
+
+*/
+// Code Implementation File Information /////////////////////////////
+/**
+* @file pcbHeap.c
+*
+* @brief Implementation file for pcbHeap code
+*
+* @details Implements all functions of the indexed PCB min-heap
+*/
+// Program Description/Support /////////////////////////////////////
+/*
+This program holds Ready process control blocks in a binary min-heap
+ordered by a comparison function. Each PCB stores its own position in
+the heap, so a PCB can be removed without searching. A PCB's key only
+changes while it is Running, out of the heap.
+*/
+// Header Files ///////////////////////////////////////////////////
+//
+#include "pcbHeap.h"
+//
+// Global Constant Definitions ////////////////////////////////////
+//
+///// NONE
+//
+// Free Function Prototypes ///////////////////////////////////////
+//
+//==========================================================================
+/**
+* @brief Function swaps two heap slots and keeps their indices current
+*
+* @param[in] heap
+* A PCBHeap pointer
+*
+* @param[in] first
+* Index of the first slot
+*
+* @param[in] second
+* Index of the second slot
+*/
+static void swapSlots( PCBHeap *heap, int first, int second )
+{
+	ProcessControlBlock *temp = heap->blocks[ first ];
+
+	heap->blocks[ first ] = heap->blocks[ second ];
+	heap->blocks[ second ] = temp;
+
+	heap->blocks[ first ]->heapIndex = first;
+	heap->blocks[ second ]->heapIndex = second;
+}
+
+//==========================================================================
+/**
+* @brief Function moves a slot toward the root until its parent is smaller
+*
+* @param[in] heap
+* A PCBHeap pointer
+*
+* @param[in] index
+* Index of the slot to move
+*
+* @return the final index of the slot
+*/
+static int siftUp( PCBHeap *heap, int index )
+{
+	int parent;
+
+	while( index > 0 )
+	{
+		parent = ( index - 1 ) / 2;
+
+		if( heap->compare( heap->blocks[ index ],
+		                   heap->blocks[ parent ] ) >= 0 )
+		{
+			break;
+		}
+		swapSlots( heap, index, parent );
+		index = parent;
+	}
+	return index;
+}
+
+//==========================================================================
+/**
+* @brief Function moves a slot toward the leaves until both children are
+*	larger
+*
+* @param[in] heap
+* A PCBHeap pointer
+*
+* @param[in] index
+* Index of the slot to move
+*/
+static void siftDown( PCBHeap *heap, int index )
+{
+	int child, smallest;
+
+	while( 1 )
+	{
+		smallest = index;
+		child = 2 * index + 1;
+
+		if( child < heap->count &&
+			heap->compare( heap->blocks[ child ],
+			               heap->blocks[ smallest ] ) < 0 )
+		{
+			smallest = child;
+		}
+		child++;
+		if( child < heap->count &&
+			heap->compare( heap->blocks[ child ],
+			               heap->blocks[ smallest ] ) < 0 )
+		{
+			smallest = child;
+		}
+
+		if( smallest == index )
+		{
+			return;
+		}
+		swapSlots( heap, index, smallest );
+		index = smallest;
+	}
+}
+
+//==========================================================================
+/**
+* @brief Function creates an empty heap able to hold capacity PCBs
+*
+* @details Function allocates the heap struct and its slot array, and
+*   stores the comparison function used to order the PCBs.
+*
+* @param[in] capacity
+* Maximum number of PCBs the heap will hold
+*
+* @param[in] compare
+* Function ordering two PCBs
+*
+* @return a pointer to the new heap
+*/
+PCBHeap *createPCBHeap( int capacity, PCBCompare compare )
+{
+	PCBHeap *heap = malloc( sizeof( PCBHeap ) );
+
+	if( capacity < 1 )
+	{
+		capacity = 1;
+	}
+	heap->count = 0;
+	heap->capacity = capacity;
+	heap->compare = compare;
+	heap->blocks = malloc( sizeof( ProcessControlBlock * ) * capacity );
+
+	return heap;
+}
+
+//==========================================================================
+/**
+* @brief Function frees the heap, the PCBs inside are not freed
+*
+* @param[in] heap
+* A PCBHeap pointer
+*
+* @return a freed and nulled PCBHeap pointer
+*/
+PCBHeap *destroyPCBHeap( PCBHeap *heap )
+{
+	int index;
+
+	for( index = 0; index < heap->count; index++ )
+	{
+		heap->blocks[ index ]->heapIndex = -1;
+	}
+	free( heap->blocks );
+	free( heap );
+
+	heap = NULL;
+	return heap;
+}
+
+//==========================================================================
+/**
+* @brief Function adds a PCB to the heap
+*
+* @details Function places the PCB in the last slot and sifts it up.
+*   A PCB already in the heap is left where it is.
+*
+* @param[in] heap
+* A PCBHeap pointer
+*
+* @param[in] pcb
+* The PCB to insert
+*/
+void heapInsertPCB( PCBHeap *heap, ProcessControlBlock *pcb )
+{
+	if( pcb->heapIndex >= 0 )
+	{
+		return;
+	}
+
+	if( heap->count == heap->capacity )
+	{
+		heap->capacity *= 2;
+		heap->blocks = realloc( heap->blocks,
+		                sizeof( ProcessControlBlock * ) * heap->capacity );
+	}
+
+	heap->blocks[ heap->count ] = pcb;
+	pcb->heapIndex = heap->count;
+	heap->count++;
+
+	siftUp( heap, pcb->heapIndex );
+}
+
+//==========================================================================
+/**
+* @brief Function removes and returns the smallest PCB in the heap
+*
+* @param[in] heap
+* A PCBHeap pointer
+*
+* @return the smallest PCB, or NULL if the heap is empty
+*/
+ProcessControlBlock *heapRemoveMin( PCBHeap *heap )
+{
+	ProcessControlBlock *minBlock = heapPeekMin( heap );
+
+	if( minBlock != NULL )
+	{
+		heapRemovePCB( heap, minBlock );
+	}
+	return minBlock;
+}
+
+//==========================================================================
+/**
+* @brief Function returns the smallest PCB without removing it
+*
+* @param[in] heap
+* A PCBHeap pointer
+*
+* @return the smallest PCB, or NULL if the heap is empty
+*/
+ProcessControlBlock *heapPeekMin( PCBHeap *heap )
+{
+	if( heap->count == 0 )
+	{
+		return NULL;
+	}
+	return heap->blocks[ 0 ];
+}
+
+//==========================================================================
+/**
+* @brief Function removes the given PCB from anywhere in the heap
+*
+* @details Function moves the last slot into the removed PCB's slot, then
+*   sifts that slot in whichever direction restores the heap order.
+*   A PCB not in the heap is ignored.
+*
+* @param[in] heap
+* A PCBHeap pointer
+*
+* @param[in] pcb
+* The PCB to remove
+*/
+void heapRemovePCB( PCBHeap *heap, ProcessControlBlock *pcb )
+{
+	int index = pcb->heapIndex;
+
+	if( index < 0 || index >= heap->count || heap->blocks[ index ] != pcb )
+	{
+		return;
+	}
+
+	heap->count--;
+	pcb->heapIndex = -1;
+
+	if( index == heap->count )
+	{
+		return;
+	}
+
+	heap->blocks[ index ] = heap->blocks[ heap->count ];
+	heap->blocks[ index ]->heapIndex = index;
+
+	if( siftUp( heap, index ) == index )
+	{
+		siftDown( heap, index );
+	}
+}
+
+//==========================================================================
+/**
+* @brief Function orders PCBs by remaining process time
+*
+* @details Ties are broken by the lower PID, which matches the order the
+*   process list was scanned in before the heap existed.
+*
+* @param[in] first
+* A PCB pointer
+*
+* @param[in] second
+* A PCB pointer
+*
+* @return negative if first runs before second, positive otherwise
+*/
+int compareProcessTime( ProcessControlBlock *first,
+                        ProcessControlBlock *second )
+{
+	if( first->processTime != second->processTime )
+	{
+		return first->processTime < second->processTime ? -1 : 1;
+	}
+	return first->pid - second->pid;
+}
+
+//==========================================================================
+/**
+* @brief Function orders PCBs by stride scheduling pass value
+*
+* @details The PCB that has used the least CPU relative to its tickets has
+*   the lowest pass and runs next. Ties go to the lower PID.
+*
+* @param[in] first
+* A PCB pointer
+*
+* @param[in] second
+* A PCB pointer
+*
+* @return negative if first runs before second, positive otherwise
+*/
+int comparePass( ProcessControlBlock *first, ProcessControlBlock *second )
+{
+	if( first->pass != second->pass )
+	{
+		return first->pass < second->pass ? -1 : 1;
+	}
+	return first->pid - second->pid;
+}
+
+//==========================================================================
+// Terminating Precompiler Directives ///////////////////////////////
+//
+///// NONE
+//
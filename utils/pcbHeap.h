@@ -0,0 +1,86 @@
+// PROGRAMMER INFORMATION ////////////////////////////////////////////
+/**
+
+Secret Number: 764819
+
+*/
+// Header File Information /////////////////////////////////////
+/**
+* @file pcbHeap.h
+*
+* @brief Header file for pcbHeap code
+*
+* @details Specifies functions, constants, and other information
+* related to the indexed binary min-heap of process control blocks
+*/
+// Precompiler Directives //////////////////////////////////////////
+//
+#ifndef PCB_HEAP_H
+#define PCB_HEAP_H
+//
+// Header Files ///////////////////////////////////////////////////
+//
+#include <stdlib.h>
+#include "processList.h"
+//
+// Global Constant Definitions ////////////////////////////////////
+//
+///// NONE
+//
+// Data Structure Definitions (structs, enums, etc.)////////////////
+//
+/*
+  Returns negative if first should leave the heap before second, positive
+  if after, and zero if they are equal
+*/
+typedef int ( *PCBCompare )( ProcessControlBlock *first,
+                             ProcessControlBlock *second );
+
+typedef struct PCBHeap
+{
+	int count;
+	int capacity;
+	PCBCompare compare;
+	ProcessControlBlock **blocks;
+} PCBHeap;
+//
+// Free Function Prototypes ///////////////////////////////////////
+//
+//==========================================================================
+
+PCBHeap *createPCBHeap( int capacity, PCBCompare compare );
+
+//==========================================================================
+
+PCBHeap *destroyPCBHeap( PCBHeap *heap );
+
+//==========================================================================
+
+void heapInsertPCB( PCBHeap *heap, ProcessControlBlock *pcb );
+
+//==========================================================================
+
+ProcessControlBlock *heapRemoveMin( PCBHeap *heap );
+
+//==========================================================================
+
+ProcessControlBlock *heapPeekMin( PCBHeap *heap );
+
+//==========================================================================
+
+void heapRemovePCB( PCBHeap *heap, ProcessControlBlock *pcb );
+
+
+//==========================================================================
+
+int compareProcessTime( ProcessControlBlock *first,
+                        ProcessControlBlock *second );
+
+//==========================================================================
+
+int comparePass( ProcessControlBlock *first, ProcessControlBlock *second );
+
+// Terminating Precompiler Directives ///////////////////////////////
+//
+#endif // PCB_HEAP_H
+//
@@ -0,0 +1,206 @@
+// PROGRAMMER INFORMATION ////////////////////////////////////////////
+/**
+
+Secret Number: 764819
+
+*/
+// Code Implementation File Information /////////////////////////////
+/**
+* @file pidBitmap.c
+*
+* @brief Implementation file for pidBitmap code
+*
+* @details Implements all functions of the hierarchical PID bitmap
+*/
+// Program Description/Support /////////////////////////////////////
+/*
+This program keeps a set of process IDs as a tree of 64 bit words, so
+the smallest PID in the set is found with one count-trailing-zeros per
+level instead of a scan over every process.
+*/
+// Header Files ///////////////////////////////////////////////////
+//
+#include "pidBitmap.h"
+//
+// Global Constant Definitions ////////////////////////////////////
+//
+const int BITS_PER_WORD = 64;
+const int WORD_SHIFT = 6;
+//
+// Free Function Prototypes ///////////////////////////////////////
+//
+//==========================================================================
+/**
+* @brief Function creates an empty bitmap for PIDs 0 to size - 1
+*
+* @details Function sizes each level from the one below it until a level
+*   fits in a single word, and clears every word.
+*
+* @param[in] size
+* Number of PIDs the bitmap can hold
+*
+* @return a pointer to the new bitmap
+*/
+PIDBitmap *createPIDBitmap( int size )
+{
+	PIDBitmap *bitmap = malloc( sizeof( PIDBitmap ) );
+	int words, level;
+
+	if( size < 1 )
+	{
+		size = 1;
+	}
+	bitmap->size = size;
+
+	bitmap->numLevels = 1;
+	words = ( size + BITS_PER_WORD - 1 ) >> WORD_SHIFT;
+	while( words > 1 )
+	{
+		bitmap->numLevels++;
+		words = ( words + BITS_PER_WORD - 1 ) >> WORD_SHIFT;
+	}
+
+	bitmap->levels = malloc( sizeof( unsigned long long * ) *
+	                         bitmap->numLevels );
+	words = size;
+	for( level = 0; level < bitmap->numLevels; level++ )
+	{
+		words = ( words + BITS_PER_WORD - 1 ) >> WORD_SHIFT;
+		bitmap->levels[ level ] = calloc( words,
+		                                  sizeof( unsigned long long ) );
+	}
+
+	return bitmap;
+}
+
+//==========================================================================
+/**
+* @brief Function frees every level of the bitmap and the bitmap
+*
+* @param[in] bitmap
+* A PIDBitmap pointer
+*
+* @return a freed and nulled PIDBitmap pointer
+*/
+PIDBitmap *destroyPIDBitmap( PIDBitmap *bitmap )
+{
+	int level;
+
+	for( level = 0; level < bitmap->numLevels; level++ )
+	{
+		free( bitmap->levels[ level ] );
+	}
+	free( bitmap->levels );
+	free( bitmap );
+
+	bitmap = NULL;
+	return bitmap;
+}
+
+//==========================================================================
+/**
+* @brief Function adds a PID to the set
+*
+* @details Function sets the PID's bit, then the bit for its word in each
+*   level above, stopping once a parent bit was already set.
+*
+* @param[in] bitmap
+* A PIDBitmap pointer
+*
+* @param[in] pid
+* The PID to add
+*/
+void bitmapSetPID( PIDBitmap *bitmap, int pid )
+{
+	int level, index = pid;
+	unsigned long long bit, *word;
+
+	if( pid < 0 || pid >= bitmap->size )
+	{
+		return;
+	}
+
+	for( level = 0; level < bitmap->numLevels; level++ )
+	{
+		word = &bitmap->levels[ level ][ index >> WORD_SHIFT ];
+		bit = 1ULL << ( index & ( BITS_PER_WORD - 1 ) );
+
+		if( *word & bit )
+		{
+			return;
+		}
+		*word |= bit;
+		index >>= WORD_SHIFT;
+	}
+}
+
+//==========================================================================
+/**
+* @brief Function removes a PID from the set
+*
+* @details Function clears the PID's bit, and clears the bit for its word
+*   in the level above only when the word has become empty.
+*
+* @param[in] bitmap
+* A PIDBitmap pointer
+*
+* @param[in] pid
+* The PID to remove
+*/
+void bitmapClearPID( PIDBitmap *bitmap, int pid )
+{
+	int level, index = pid;
+	unsigned long long *word;
+
+	if( pid < 0 || pid >= bitmap->size )
+	{
+		return;
+	}
+
+	for( level = 0; level < bitmap->numLevels; level++ )
+	{
+		word = &bitmap->levels[ level ][ index >> WORD_SHIFT ];
+		*word &= ~( 1ULL << ( index & ( BITS_PER_WORD - 1 ) ) );
+
+		if( *word != 0 )
+		{
+			return;
+		}
+		index >>= WORD_SHIFT;
+	}
+}
+
+//==========================================================================
+/**
+* @brief Function returns the smallest PID in the set
+*
+* @details Function walks down from the top word, taking the lowest set
+*   bit at each level to pick the word to look at in the level below.
+*
+* @param[in] bitmap
+* A PIDBitmap pointer
+*
+* @return the smallest PID in the set, or -1 if the set is empty
+*/
+int bitmapFirstPID( PIDBitmap *bitmap )
+{
+	int level, index = 0;
+	unsigned long long word;
+
+	for( level = bitmap->numLevels - 1; level >= 0; level-- )
+	{
+		word = bitmap->levels[ level ][ index ];
+		if( word == 0 )
+		{
+			return -1;
+		}
+		index = ( index << WORD_SHIFT ) + __builtin_ctzll( word );
+	}
+	return index;
+}
+
+//==========================================================================
+// Terminating Precompiler Directives ///////////////////////////////
+//
+///// NONE
+//
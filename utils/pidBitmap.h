@@ -0,0 +1,67 @@
+// PROGRAMMER INFORMATION ////////////////////////////////////////////
+/**
+
+Secret Number: 764819
+
+*/
+// Header File Information /////////////////////////////////////
+/**
+* @file pidBitmap.h
+*
+* @brief Header file for pidBitmap code
+*
+* @details Specifies functions, constants, and other information
+* related to the hierarchical bitmap of process IDs
+*/
+// Precompiler Directives //////////////////////////////////////////
+//
+#ifndef PID_BITMAP_H
+#define PID_BITMAP_H
+//
+// Header Files ///////////////////////////////////////////////////
+//
+#include <stdlib.h>
+//
+// Global Constant Definitions ////////////////////////////////////
+//
+///// NONE
+//
+// Data Structure Definitions (structs, enums, etc.)////////////////
+//
+/*
+  levels[ 0 ] holds one bit per PID. Each word of level k has its bit set
+  in level k + 1 when it is nonzero. The top level is a single word.
+*/
+typedef struct PIDBitmap
+{
+	int size;
+	int numLevels;
+	unsigned long long **levels;
+} PIDBitmap;
+//
+// Free Function Prototypes ///////////////////////////////////////
+//
+//==========================================================================
+
+PIDBitmap *createPIDBitmap( int size );
+
+//==========================================================================
+
+PIDBitmap *destroyPIDBitmap( PIDBitmap *bitmap );
+
+//==========================================================================
+
+void bitmapSetPID( PIDBitmap *bitmap, int pid );
+
+//==========================================================================
+
+void bitmapClearPID( PIDBitmap *bitmap, int pid );
+
+//==========================================================================
+
+int bitmapFirstPID( PIDBitmap *bitmap );
+
+// Terminating Precompiler Directives ///////////////////////////////
+//
+#endif // PID_BITMAP_H
+//
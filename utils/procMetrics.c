@@ -0,0 +1,303 @@
+// PROGRAMMER INFORMATION ////////////////////////////////////////////
+/**
+
+Secret Number: 764819
+
+*/
+// Code Implementation File Information /////////////////////////////
+/**
+* @file procMetrics.c
+*
+* @brief Implementation file for procMetrics code
+*
+* @details Implements all functions of the per-process metrics report
+*/
+// Program Description/Support /////////////////////////////////////
+/*
+This program turns the times each process control block records as it
+changes state into turnaround, response, waiting and blocked times, and
+summarizes them across all processes as a mean and percentiles. The
+values can also be written out as a CSV file.
+*/
+// Header Files ///////////////////////////////////////////////////
+//
+#include "procMetrics.h"
+#include "utilities.h"
+//
+// Global Constant Definitions ////////////////////////////////////
+//
+// CSV column names, in PROC_METRIC order
+const char *METRIC_NAMES[] = { "arrival", "first_run", "completion",
+                               "turnaround", "response", "ready_wait",
+                               "blocked" };
+//
+// Free Function Prototypes ///////////////////////////////////////
+//
+//==========================================================================
+/**
+* @brief Function orders two doubles for qsort
+*
+* @param[in] first
+* A pointer to a double
+*
+* @param[in] second
+* A pointer to a double
+*
+* @return negative, zero or positive as first is below, equal or above
+*/
+static int compareDouble( const void *first, const void *second )
+{
+    double left = *( const double * )first;
+    double right = *( const double * )second;
+
+    return ( left > right ) - ( left < right );
+}
+
+//==========================================================================
+/**
+* @brief Function returns one metric of a PCB in milliseconds
+*
+* @details Arrival is when the PCB left New, response is first run less
+*   arrival and turnaround is completion less arrival. A PCB that never
+*   reached a state reports zero for the times that depend on it.
+*
+* @param[in] pcb
+* A PCB pointer
+*
+* @param[in] metric
+* The metric to return
+*
+* @return the metric in milliseconds
+*/
+double pcbMetric( ProcessControlBlock *pcb, PROC_METRIC metric )
+{
+    double value = 0.0;
+
+    switch( metric )
+    {
+        case ARRIVAL:
+            value = pcb->arrivalTime;
+            break;
+
+        case FIRST_RUN:
+            value = pcb->firstRunTime >= 0.0 ? pcb->firstRunTime : 0.0;
+            break;
+
+        case COMPLETION:
+            value = pcb->completionTime;
+            break;
+
+        case TURNAROUND:
+            value = pcb->state == EXIT ?
+                    pcb->completionTime - pcb->arrivalTime : 0.0;
+            break;
+
+        case RESPONSE:
+            value = pcb->firstRunTime >= 0.0 ?
+                    pcb->firstRunTime - pcb->arrivalTime : 0.0;
+            break;
+
+        case READY_WAIT:
+            value = pcb->readyWaitTime;
+            break;
+
+        case BLOCKED_TIME:
+            value = pcb->blockedTime;
+            break;
+
+        default:
+            break;
+    }
+    return value * 1000.0;
+}
+
+//==========================================================================
+/**
+* @brief Function returns the nearest-rank percentile of sorted values
+*
+* @param[in] sorted
+* Values in ascending order
+*
+* @param[in] count
+* Number of values
+*
+* @param[in] percent
+* The percentile wanted, 1 to 100
+*
+* @return the smallest value at or above the given percent of the values
+*/
+double percentile( double *sorted, int count, int percent )
+{
+    // rank is percent of count rounded up, without needing libm's ceil
+    int rank = ( percent * count + 99 ) / 100;
+
+    if( count == 0 )
+    {
+        return 0.0;
+    }
+    if( rank < 1 )
+    {
+        rank = 1;
+    }
+    return sorted[ rank - 1 ];
+}
+
+//==========================================================================
+/**
+* @brief Function summarizes one metric across every process
+*
+* @param[in] list
+* A ProcessList pointer
+*
+* @param[in] metric
+* The metric to summarize
+*
+* @param[out] summary
+* Receives the mean and the 50th, 95th and 99th percentiles
+*/
+void summarizeMetric( ProcessList *list, PROC_METRIC metric,
+                      MetricSummary *summary )
+{
+    int count = procListCount( list );
+    double *values = malloc( sizeof( double ) * ( count + 1 ) );
+    ProcessControlBlock *currBlock = procListFirst( list );
+    double total = 0.0;
+    int index = 0;
+
+    while( currBlock != NULL )
+    {
+        values[ index ] = pcbMetric( currBlock, metric );
+        total += values[ index ];
+        index++;
+        currBlock = currBlock->next;
+    }
+    qsort( values, count, sizeof( double ), compareDouble );
+
+    summary->mean = count > 0 ? total / count : 0.0;
+    summary->p50 = percentile( values, count, 50 );
+    summary->p95 = percentile( values, count, 95 );
+    summary->p99 = percentile( values, count, 99 );
+
+    free( values );
+}
+
+//==========================================================================
+/**
+* @brief Function returns the share of CPU time spent running processes
+*
+* @param[in] list
+* A ProcessList pointer
+*
+* @param[in] makespan
+* Seconds from the start of the simulation to the end
+*
+* @param[in] cpuCount
+* Number of CPUs the run was spread over
+*
+* @return time spent Running over the time all CPUs were available, as a
+*   percentage
+*/
+double cpuUtilization( ProcessList *list, double makespan, int cpuCount )
+{
+    ProcessControlBlock *currBlock = procListFirst( list );
+    double busyTime = 0.0;
+
+    if( makespan <= 0.0 || cpuCount < 1 )
+    {
+        return 0.0;
+    }
+
+    while( currBlock != NULL )
+    {
+        busyTime += currBlock->runTime;
+        currBlock = currBlock->next;
+    }
+    return 100.0 * busyTime / ( makespan * cpuCount );
+}
+
+//==========================================================================
+/**
+* @brief Function writes the metrics of every process as a CSV file
+*
+* @details One row per process, then one row each for the mean and the
+*   percentiles with the statistic named in the pid column, then the CPU
+*   utilization. Times are in milliseconds.
+*
+* @param[in] fileName
+* Path of the CSV file to create
+*
+* @param[in] list
+* A ProcessList pointer
+*
+* @param[in] makespan
+* Seconds from the start of the simulation to the end
+*
+* @param[in] cpuCount
+* Number of CPUs the run was spread over
+*
+* @return no error message if written, file open error otherwise
+*/
+int writeMetricsFile( char *fileName, ProcessList *list, double makespan,
+                      int cpuCount )
+{
+    FILE *file = writeToFile( fileName );
+    ProcessControlBlock *currBlock = procListFirst( list );
+    MetricSummary summary[ NUM_METRICS ];
+    int metric;
+
+    if( file == NULL )
+    {
+        return OPEN_FILE_FAIL;
+    }
+
+    fprintf( file, "pid" );
+    for( metric = 0; metric < NUM_METRICS; metric++ )
+    {
+        fprintf( file, ",%s", METRIC_NAMES[ metric ] );
+        summarizeMetric( list, metric, &summary[ metric ] );
+    }
+    fprintf( file, "\n" );
+
+    while( currBlock != NULL )
+    {
+        fprintf( file, "%d", currBlock->pid );
+        for( metric = 0; metric < NUM_METRICS; metric++ )
+        {
+            fprintf( file, ",%.3f", pcbMetric( currBlock, metric ) );
+        }
+        fprintf( file, "\n" );
+        currBlock = currBlock->next;
+    }
+
+    fprintf( file, "mean" );
+    for( metric = 0; metric < NUM_METRICS; metric++ )
+    {
+        fprintf( file, ",%.3f", summary[ metric ].mean );
+    }
+    fprintf( file, "\np50" );
+    for( metric = 0; metric < NUM_METRICS; metric++ )
+    {
+        fprintf( file, ",%.3f", summary[ metric ].p50 );
+    }
+    fprintf( file, "\np95" );
+    for( metric = 0; metric < NUM_METRICS; metric++ )
+    {
+        fprintf( file, ",%.3f", summary[ metric ].p95 );
+    }
+    fprintf( file, "\np99" );
+    for( metric = 0; metric < NUM_METRICS; metric++ )
+    {
+        fprintf( file, ",%.3f", summary[ metric ].p99 );
+    }
+    fprintf( file, "\ncpu_utilization,%.1f\n",
+             cpuUtilization( list, makespan, cpuCount ) );
+
+    closeFile( file );
+    return NO_ERROR_MSG;
+}
+
+//==========================================================================
+// Terminating Precompiler Directives ///////////////////////////////
+//
+///// NONE
+//
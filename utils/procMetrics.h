@@ -0,0 +1,74 @@
+// PROGRAMMER INFORMATION ////////////////////////////////////////////
+/**
+
+Secret Number: 764819
+
+*/
+// Header File Information /////////////////////////////////////
+/**
+* @file procMetrics.h
+*
+* @brief Header file for procMetrics code
+*
+* @details Specifies functions, constants, and other information
+* related to the per-process performance metrics
+*/
+// Precompiler Directives //////////////////////////////////////////
+//
+#ifndef PROC_METRICS_H
+#define PROC_METRICS_H
+//
+// Header Files ///////////////////////////////////////////////////
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include "processList.h"
+//
+// Global Constant Definitions ////////////////////////////////////
+//
+extern const char *METRIC_NAMES[];
+//
+// Data Structure Definitions (structs, enums, etc.)////////////////
+//
+typedef enum PROC_METRIC
+{
+    ARRIVAL, FIRST_RUN, COMPLETION, TURNAROUND, RESPONSE, READY_WAIT,
+    BLOCKED_TIME, NUM_METRICS
+} PROC_METRIC;
+
+typedef struct MetricSummary
+{
+    double mean;
+    double p50;
+    double p95;
+    double p99;
+} MetricSummary;
+//
+// Free Function Prototypes ///////////////////////////////////////
+//
+//==========================================================================
+
+double pcbMetric( ProcessControlBlock *pcb, PROC_METRIC metric );
+
+//==========================================================================
+
+double percentile( double *sorted, int count, int percent );
+
+//==========================================================================
+
+void summarizeMetric( ProcessList *list, PROC_METRIC metric,
+                      MetricSummary *summary );
+
+//==========================================================================
+
+double cpuUtilization( ProcessList *list, double makespan, int cpuCount );
+
+//==========================================================================
+
+int writeMetricsFile( char *fileName, ProcessList *list, double makespan,
+                      int cpuCount );
+
+// Terminating Precompiler Directives ///////////////////////////////
+//
+#endif // PROC_METRICS_H
+//
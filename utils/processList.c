@@ -29,10 +29,16 @@ operating system processes.
 #include "processList.h"
 #include "metadataList.h"
 #include "utilities.h"
+#include "pidBitmap.h"
+#include "simtimer.h"
 //
 // Global Constant Definitions ////////////////////////////////////
 //
 const int STD_STR = 200;
+
+// a process's stride is STRIDE_ONE divided by its tickets
+const int DEFAULT_TICKETS = 100;
+const long STRIDE_ONE = 1L << 20;
 //
 // Free Function Prototypes ///////////////////////////////////////
 //
@@ -57,9 +63,24 @@ const int STD_STR = 200;
 ProcessList *procListCreate()
 {
     ProcessList *list = malloc( sizeof( ProcessList ));
+    int state;
 
     list->first = NULL;
+    list->last = NULL;
     list->count = 0;
+    list->onStateChange = NULL;
+    list->stateOwner = NULL;
+    list->clock = NULL;
+    list->mdList = NULL;
+    list->readySet = NULL;
+    list->pidTable = NULL;
+    pthread_mutex_init( &list->lock, NULL );
+
+    for( state = 0; state < NUM_STATES; state++ )
+    {
+        list->stateCount[ state ] = 0;
+        list->stateFirst[ state ] = NULL;
+    }
 
     return list;
 }
@@ -95,21 +116,105 @@ ProcessControlBlock *createPCB( MetadataNode *process, int pid )
     node->processHead = process;
     node->next = NULL;
 	node->nextInQueue = NULL;
+	node->prevInQueue = NULL;
+	node->inQueue = 0;
+	node->heapIndex = -1;
+	node->prevInState = NULL;
+	node->nextInState = NULL;
+	node->priority = 0;
+	node->arrivalTime = 0.0;
+	node->firstRunTime = -1.0;
+	node->completionTime = 0.0;
+	node->readyWaitTime = 0.0;
+	node->blockedTime = 0.0;
+	node->runTime = 0.0;
+	node->stateTime = 0.0;
+
+	// the A(start) value is the process's ticket count for STRIDE-P
+	node->tickets = process->value > 0 ? process->value : DEFAULT_TICKETS;
+	node->stride = STRIDE_ONE / node->tickets;
+	node->pass = 0;
+	node->cyclesRun = 0;
+
+	// progress through the op at processHead, the metadata is only read
+	node->opCyclesDone = 0;
+	node->segFaulted = 0;
+
+	// when the I/O at processHead ends, while the PCB is Blocked on it
+	node->ioDueTime = 0.0;
+
+	// the PCB's own allocations, chained through the MMU's nodes
+	node->firstAlloc = NULL;
+	node->pageTable = NULL;
 
     return node;
 }
 
+//==========================================================================
+/**
+* @brief Function links a PCB into the set for its current state
+*
+* @param[in] list
+* A ProcessList pointer
+*
+* @param[in] pcb
+* A ProcessControlBlock pointer
+*/
+static void linkState( ProcessList *list, ProcessControlBlock *pcb )
+{
+    ProcessControlBlock *head = list->stateFirst[ pcb->state ];
+
+    pcb->prevInState = NULL;
+    pcb->nextInState = head;
+    if( head != NULL )
+    {
+        head->prevInState = pcb;
+    }
+    list->stateFirst[ pcb->state ] = pcb;
+    list->stateCount[ pcb->state ]++;
+}
+
+//==========================================================================
+/**
+* @brief Function unlinks a PCB from the set for its current state
+*
+* @param[in] list
+* A ProcessList pointer
+*
+* @param[in] pcb
+* A ProcessControlBlock pointer
+*/
+static void unlinkState( ProcessList *list, ProcessControlBlock *pcb )
+{
+    if( pcb->prevInState != NULL )
+    {
+        pcb->prevInState->nextInState = pcb->nextInState;
+    }
+    else
+    {
+        list->stateFirst[ pcb->state ] = pcb->nextInState;
+    }
+    if( pcb->nextInState != NULL )
+    {
+        pcb->nextInState->prevInState = pcb->prevInState;
+    }
+
+    pcb->prevInState = NULL;
+    pcb->nextInState = NULL;
+    list->stateCount[ pcb->state ]--;
+}
+
 //==========================================================================
 /**
 * @brief Function appends a node to the end of a list
 *
-* @details Function finds ending node in list and appends given node
+* @details Function links the given node after the list's last node
+*   and into the set for the node's current state
 *
 * @par Algorithm
-*   Function takes a node and a list, finds the ending node in the list,
-*   and links that last node to the given node, making the given node the
-*   new last node in the list. If the list is empty, it makes the given
-*   node the head of the list.
+*   Function takes a node and a list, links the list's last node to the
+*   given node, making the given node the new last node in the list.
+*   If the list is empty, it makes the given node the head of the list.
 *
 * @param[in] list
 * A ProcessList pointer
@@ -119,21 +224,18 @@ ProcessControlBlock *createPCB( MetadataNode *process, int pid )
 */
 void listAddPCB( ProcessList *list, ProcessControlBlock *node )
 {
+    linkState( list, node );
+
     if( list->first == NULL && list->count == 0 )
     {
         list->first = node;
+        list->last = node;
         list->count++;
         return;
     }
 
-    ProcessControlBlock *currNode = list->first;
-
-    while( currNode->next != NULL )
-    {
-        currNode = currNode->next;
-    }
-
-    currNode->next = node;
+    list->last->next = node;
+    list->last = node;
     list->count++;
 
     return;
@@ -157,6 +259,11 @@ void listAddPCB( ProcessList *list, ProcessControlBlock *node )
 */
 static void freePCBs( ProcessList *list )
 {
+    if( list->first == NULL )
+    {
+        return;
+    }
+
     ProcessControlBlock *next = list->first->next;
 
     while( next != NULL )
@@ -169,6 +276,7 @@ static void freePCBs( ProcessList *list )
     free( list->first );
 
     list->first = NULL;
+    list->last = NULL;
     list->count = 0;
 }
 
@@ -190,7 +298,13 @@ static void freePCBs( ProcessList *list )
 */
 ProcessList *procListDestroy( ProcessList *list )
 {
+    if( list->readySet != NULL )
+    {
+        list->readySet = destroyPIDBitmap( list->readySet );
+    }
+    free( list->pidTable );
     freePCBs( list );
+    pthread_mutex_destroy( &list->lock );
     free( list );
 
     list = NULL;
@@ -243,6 +357,35 @@ ProcessControlBlock *procListFirst( ProcessList *list )
     return list->first;
 }
 
+//==========================================================================
+/**
+* @brief Function builds the PID lookup table and the Ready PID bitmap
+*
+* @details PIDs are handed out in order from zero, so the table is indexed
+*   directly by PID. PCBs already Ready are added to the bitmap.
+*
+* @param[in] list
+* A ProcessList pointer
+*/
+static void indexPIDs( ProcessList *list )
+{
+    ProcessControlBlock *currBlock = procListFirst( list );
+
+    list->pidTable = malloc( sizeof( ProcessControlBlock * ) *
+                             ( list->count + 1 ) );
+    list->readySet = createPIDBitmap( list->count );
+
+    while( currBlock != NULL )
+    {
+        list->pidTable[ currBlock->pid ] = currBlock;
+        if( currBlock->state == READY )
+        {
+            bitmapSetPID( list->readySet, currBlock->pid );
+        }
+        currBlock = currBlock->next;
+    }
+}
+
 //==========================================================================
 /**
 * @brief Function creates a Process List and fills it with process control
@@ -250,6 +393,7 @@ ProcessControlBlock *procListFirst( ProcessList *list )
 *
 * @details Function iterates through the metadataList, and creates a
 *   process control block struct for each application-start opCode.
+*   The list keeps the metadata, which its PCBs point into.
 *
 * @par Algorithm
 *   Function creates a process control block for every application-start
@@ -287,6 +431,8 @@ int fillProcessList( ProcessList *list,
     if( currOp->command == 'S' &&
         stringCompare( currOp->operation, "end" ) == 0 )
     {
+        list->mdList = mdList;
+        indexPIDs( list );
         calculateProcessTime( list, configData );
         return NO_ERROR_MSG;
     }
@@ -367,12 +513,179 @@ void setReady( ProcessList *list )
     {
         if( currBlock->state == NEW )
         {
-            currBlock->state = READY;
+            setPCBState( list, currBlock, READY );
         }
         currBlock = currBlock->next;
     }
 }
 
+//==========================================================================
+/**
+* @brief Function moves a PCB into the given state
+*
+* @details Function is the single place a PCB changes state. It moves the
+*   PCB between the per-state sets, which keeps the per-state counts
+*   exact, and keeps the Ready PID bitmap holding exactly the Ready PCBs.
+*   The registered hook, the scheduler, hears of every change so it can
+*   keep its own ready structures. The time of each change is charged to
+*   the state being left, and arrival, first run and completion are
+*   stamped, for the metrics report.
+*
+* @par Algorithm
+*   Function unlinks the PCB from the set of its old state, clears its
+*   Ready bit if it was Ready, stores the new state, links it into the new
+*   state's set, sets its Ready bit if now Ready and calls the hook. The
+*   list's lock is held throughout, since with more than one CPU several
+*   dispatchers change states at once.
+*
+* @param[in] list
+*   A pointer to the ProcessList holding the PCB
+*
+* @param[in] pcb
+*   A pointer to the PCB changing state
+*
+* @param[in] state
+*   The state the PCB moves to
+*/
+void setPCBState( ProcessList *list, ProcessControlBlock *pcb,
+                  PROC_STATE state )
+{
+    char timeStr[ 20 ];
+    double currTime;
+
+    pthread_mutex_lock( &list->lock );
+
+    if( pcb->state == state )
+    {
+        pthread_mutex_unlock( &list->lock );
+        return;
+    }
+
+    currTime = list->clock != NULL ?
+               accessTimer( list->clock, LAP_TIMER, timeStr ) : 0.0;
+    switch( pcb->state )
+    {
+        case NEW:
+            pcb->arrivalTime = currTime;
+            break;
+
+        case READY:
+            pcb->readyWaitTime += currTime - pcb->stateTime;
+            break;
+
+        case RUN:
+            pcb->runTime += currTime - pcb->stateTime;
+            break;
+
+        case BLOCKED:
+            pcb->blockedTime += currTime - pcb->stateTime;
+            break;
+
+        default:
+            break;
+    }
+    pcb->stateTime = currTime;
+
+    unlinkState( list, pcb );
+    if( pcb->state == READY )
+    {
+        if( list->readySet != NULL )
+        {
+            bitmapClearPID( list->readySet, pcb->pid );
+        }
+    }
+
+    pcb->state = state;
+
+    linkState( list, pcb );
+    if( state == READY )
+    {
+        if( list->readySet != NULL )
+        {
+            bitmapSetPID( list->readySet, pcb->pid );
+        }
+    }
+    else if( state == RUN && pcb->firstRunTime < 0.0 )
+    {
+        pcb->firstRunTime = currTime;
+    }
+    else if( state == EXIT )
+    {
+        pcb->completionTime = currTime;
+    }
+
+    if( list->onStateChange != NULL )
+    {
+        list->onStateChange( list->stateOwner, pcb, state );
+    }
+
+    pthread_mutex_unlock( &list->lock );
+}
+
+//==========================================================================
+/**
+* @brief Function returns the number of PCBs in the given state
+*
+* @param[in] list
+*   A pointer to a ProcessList
+*
+* @param[in] state
+*   The state to count
+*
+* @return count of PCBs in that state
+*/
+int procStateCount( ProcessList *list, PROC_STATE state )
+{
+    return list->stateCount[ state ];
+}
+
+//==========================================================================
+/**
+* @brief Function returns the first PCB in the given state's set
+*
+* @param[in] list
+*   A pointer to a ProcessList
+*
+* @param[in] state
+*   The state whose set is wanted
+*
+* @return a PCB in that state, or NULL if there are none
+*/
+ProcessControlBlock *procStateFirst( ProcessList *list, PROC_STATE state )
+{
+    return list->stateFirst[ state ];
+}
+
+//==========================================================================
+/**
+* @brief Function returns the Ready PCB with the lowest PID
+*
+* @details Function asks the Ready PID bitmap for its lowest set bit and
+*   looks the PCB up by PID, so the cost does not grow with the number of
+*   processes.
+*
+* @param[in] list
+*   A pointer to a ProcessList
+*
+* @return the Ready PCB with the lowest PID, or NULL if none are Ready
+*/
+ProcessControlBlock *procLowestReady( ProcessList *list )
+{
+    int pid;
+
+    if( list->readySet == NULL )
+    {
+        return NULL;
+    }
+
+    pid = bitmapFirstPID( list->readySet );
+    if( pid < 0 )
+    {
+        return NULL;
+    }
+    return list->pidTable[ pid ];
+}
+
 //==========================================================================
 /**
 * @brief
@@ -384,8 +697,13 @@ void setReady( ProcessList *list )
 ProcessControlBlock *removeFirst( ProcessList *procList )
 {
 	ProcessControlBlock *returnBlock = procList->first;
+	unlinkState( procList, returnBlock );
 	procList->first = procList->first->next;
 	procList->count--;
+	if( procList->first == NULL )
+	{
+		procList->last = NULL;
+	}
 
 	returnBlock->next = NULL;
 	return returnBlock;
@@ -406,6 +724,10 @@ void removeBlocked( ProcessList *procList, int pid )
 	if( currBlock->pid == pid )
 	{
 		procList->first = procList->first->next;
+		if( procList->last == currBlock )
+		{
+			procList->last = procList->first;
+		}
 		currBlock->next = NULL;
 		return;
 	}
@@ -416,6 +738,10 @@ void removeBlocked( ProcessList *procList, int pid )
 		{
 			ProcessControlBlock *temp = currBlock->next;
 			currBlock->next = currBlock->next->next;
+			if( procList->last == temp )
+			{
+				procList->last = currBlock;
+			}
 			temp->next = NULL;
 			return;
 		}
@@ -21,6 +21,7 @@ Secret Number: 764819
 //
 // Header Files ///////////////////////////////////////////////////
 //
+#include <pthread.h>
 #include "configParser.h"
 #include "metadataList.h"
 //
@@ -28,9 +29,11 @@ Secret Number: 764819
 //
 typedef enum PROC_STATE
 {
-    NEW, READY, RUN, BLOCKED, EXIT
+    NEW, READY, RUN, BLOCKED, EXIT, NUM_STATES
 } PROC_STATE;
 
+struct MMUNode;
+
 typedef struct ProcessControlBlock
 {
     PROC_STATE state;
@@ -39,12 +42,53 @@ typedef struct ProcessControlBlock
     MetadataNode *processHead;
     struct ProcessControlBlock *next;
 	struct ProcessControlBlock *nextInQueue;
+	struct ProcessControlBlock *prevInQueue;
+	int inQueue;
+	int heapIndex;
+	struct ProcessControlBlock *prevInState;
+	struct ProcessControlBlock *nextInState;
+	int priority;
+	double arrivalTime;
+	double firstRunTime;
+	double completionTime;
+	double readyWaitTime;
+	double blockedTime;
+	double runTime;
+	double stateTime;
+	int tickets;
+	long stride;
+	long pass;
+	int cyclesRun;
+	int opCyclesDone;
+	int segFaulted;
+	double ioDueTime;
+	struct MMUNode *firstAlloc;
+	int *pageTable;
 } ProcessControlBlock;
 
+struct PIDBitmap;
+struct SimClock;
+
+/*
+  Called after every state change, with the owner registered alongside
+*/
+typedef void ( *StateChangeHook )( void *owner, ProcessControlBlock *pcb,
+                                   PROC_STATE state );
+
 typedef struct ProcessList
 {
 	int count;
 	ProcessControlBlock *first;
+	ProcessControlBlock *last;
+	StateChangeHook onStateChange;
+	void *stateOwner;
+	struct SimClock *clock;
+	MetadataList *mdList;
+	int stateCount[ NUM_STATES ];
+	ProcessControlBlock *stateFirst[ NUM_STATES ];
+	struct PIDBitmap *readySet;
+	ProcessControlBlock **pidTable;
+	pthread_mutex_t lock;
 } ProcessList;
 //
 // Free Function Prototypes ///////////////////////////////////////
@@ -62,7 +106,7 @@ ProcessList *procListCreate();
 ProcessControlBlock *createPCB( MetadataNode *process, int pid );
 
 /*
-  Finds end of list and adds link to given node
+  Links given node after the last node in the list
 */
 void listAddPCB( ProcessList *list, ProcessControlBlock *node );
 
@@ -99,6 +143,32 @@ int calculateProcessTime( ProcessList *list, Config *configData );
 */
 void setReady( ProcessList *list );
 
+/*
+  Moves a PCB to the given state, keeping the per-state counts, the
+  per-state sets and the Ready PID bitmap in step with it, tells the
+  registered hook, and records
+  the PCB's arrival, first run, completion and time spent in each state.
+  Every state change goes through here.
+*/
+void setPCBState( ProcessList *list, ProcessControlBlock *pcb,
+                  PROC_STATE state );
+
+/*
+  Returns the number of PCBs in the list currently in the given state.
+*/
+int procStateCount( ProcessList *list, PROC_STATE state );
+
+/*
+  Returns the first PCB in the set of PCBs in the given state, the rest
+  of the set follows nextInState. The set is in no particular order.
+*/
+ProcessControlBlock *procStateFirst( ProcessList *list, PROC_STATE state );
+
+/*
+  Returns the Ready PCB with the lowest PID, or NULL if none are Ready.
+*/
+ProcessControlBlock *procLowestReady( ProcessList *list );
+
 /*
 
 */
@@ -6,15 +6,18 @@ Secret Number: 764819
 */
 // Code Implementation File Information /////////////////////////////
 /**
-* @file
+* @file readyQueue.c
 *
-* @brief
+* @brief Implementation file for readyQueue code
 *
-* @details
+* @details Implements all functions of the readyQueue utilities
 */
 // Program Description/Support /////////////////////////////////////
 /*
-
+This program holds Ready process control blocks in first in, first out
+order. The queue is linked through the PCBs themselves in both
+directions, so adding at the tail, taking from the head and removing a
+PCB from the middle are all constant time.
 */
 // Header Files ///////////////////////////////////////////////////
 //
@@ -28,92 +31,151 @@ Secret Number: 764819
 //
 //==========================================================================
 /**
-* @brief
+* @brief Function adds a PCB to the tail of the queue
 *
-* @details
+* @details Function links the PCB after the current tail. A PCB already in
+*   the queue is left where it is, so it is never linked in twice.
 *
 * @par Algorithm
+*   Function sets the PCB's queue links, points the old tail at the PCB,
+*   or the head if the queue was empty, and makes the PCB the new tail.
 *
+* @param[in] queue
+* A ReadyQueue pointer
 *
-* @param[in]
-*
-*
-* @return
+* @param[in] pcb
+* The PCB to add
 */
 void enqueuePCB( ReadyQueue *queue, ProcessControlBlock *pcb )
 {
-	if( queue->first == NULL && queue->count == 0 )
-    {
-        queue->first = pcb;
-        queue->count++;
-        return;
-    }
-
-    ProcessControlBlock *currBlock = queue->first;
-    while( currBlock->nextInQueue != NULL )
-    {
-        currBlock = currBlock->nextInQueue;
-    }
-
+	if( pcb->inQueue )
+	{
+		return;
+	}
 
-    currBlock->nextInQueue = pcb;
+	pcb->inQueue = 1;
 	pcb->nextInQueue = NULL;
-    queue->count++;
+	pcb->prevInQueue = queue->last;
 
-    return;
+	if( queue->last == NULL )
+	{
+		queue->first = pcb;
+	}
+	else
+	{
+		queue->last->nextInQueue = pcb;
+	}
+	queue->last = pcb;
+	queue->count++;
+
+	return;
 }
 
 //==========================================================================
 /**
-* @brief
-*
-* @details
-*
-* @par Algorithm
-*
-*
-* @param[out]
+* @brief Function removes and returns the PCB at the head of the queue
 *
+* @param[in] queue
+* A ReadyQueue pointer
 *
-* @return
+* @return the PCB at the head, or NULL if the queue is empty
 */
 ProcessControlBlock *dequeuePCB( ReadyQueue *queue )
 {
-	if( queue->count && queue->count != 0 )
-	{
-		ProcessControlBlock *returnBlock = queue->first;
-		queue->first = returnBlock->nextInQueue;
-		queue->count--;
-		returnBlock->nextInQueue = NULL;
+	ProcessControlBlock *returnBlock = queue->first;
 
-		return returnBlock;
+	if( returnBlock != NULL )
+	{
+		removeQueuedPCB( queue, returnBlock );
 	}
-	return NULL;
+	return returnBlock;
 }
 
 //==========================================================================
 /**
-* @brief
+* @brief Function removes the given PCB from anywhere in the queue
 *
-* @details
+* @details Used when a PCB leaves Ready without being dequeued, e.g. it is
+*   ended or preempted out of order. A PCB not in the queue is ignored.
 *
 * @par Algorithm
+*   Function links the PCB's neighbours to each other, moving the head or
+*   tail when the PCB was at either end, and clears the PCB's links.
 *
+* @param[in] queue
+* A ReadyQueue pointer
 *
-* @param[out]
-*
+* @param[in] pcb
+* The PCB to remove
+*/
+void removeQueuedPCB( ReadyQueue *queue, ProcessControlBlock *pcb )
+{
+	if( !pcb->inQueue )
+	{
+		return;
+	}
+
+	if( pcb->prevInQueue != NULL )
+	{
+		pcb->prevInQueue->nextInQueue = pcb->nextInQueue;
+	}
+	else
+	{
+		queue->first = pcb->nextInQueue;
+	}
+
+	if( pcb->nextInQueue != NULL )
+	{
+		pcb->nextInQueue->prevInQueue = pcb->prevInQueue;
+	}
+	else
+	{
+		queue->last = pcb->prevInQueue;
+	}
+
+	pcb->inQueue = 0;
+	pcb->nextInQueue = NULL;
+	pcb->prevInQueue = NULL;
+	queue->count--;
+}
+
+//==========================================================================
+/**
+* @brief Function creates an empty queue
 *
-* @return
+* @return a pointer to the new ReadyQueue
 */
 ReadyQueue *createReadyQueue()
 {
     ReadyQueue *returnQueue = malloc( sizeof( ReadyQueue ) );
     returnQueue->first = NULL;
+    returnQueue->last = NULL;
     returnQueue->count = 0;
 
     return returnQueue;
 }
 
+//==========================================================================
+/**
+* @brief Function empties the queue and frees it, the PCBs are not freed
+*
+* @param[in] queue
+* A ReadyQueue pointer
+*
+* @return a freed and nulled ReadyQueue pointer
+*/
+ReadyQueue *destroyReadyQueue( ReadyQueue *queue )
+{
+	while( queue->first != NULL )
+	{
+		removeQueuedPCB( queue, queue->first );
+	}
+	free( queue );
+
+	queue = NULL;
+	return queue;
+}
+
 //==========================================================================
 // Terminating Precompiler Directives ///////////////////////////////
 //
@@ -6,11 +6,12 @@ Secret Number: 764819
 */
 // Header File Information /////////////////////////////////////
 /**
-* @file
+* @file readyQueue.h
 *
-* @brief
+* @brief Header file for readyQueue code
 *
-* @details
+* @details Specifies functions, constants, and other information
+* related to the readyQueue code
 */
 // Precompiler Directives //////////////////////////////////////////
 //
@@ -32,6 +33,7 @@ typedef struct ReadyQueue
 {
 	int count;
 	ProcessControlBlock *first;
+	ProcessControlBlock *last;
 } ReadyQueue;
 //
 // Free Function Prototypes ///////////////////////////////////////
@@ -48,6 +50,14 @@ ProcessControlBlock *dequeuePCB( ReadyQueue *queue );
 
 ReadyQueue *createReadyQueue();
 
+//==========================================================================
+
+ReadyQueue *destroyReadyQueue( ReadyQueue *queue );
+
+//==========================================================================
+
+void removeQueuedPCB( ReadyQueue *queue, ProcessControlBlock *pcb );
+
 // Terminating Precompiler Directives ///////////////////////////////
 //
 #endif // READY_QUEUE_H
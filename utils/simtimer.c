@@ -67,22 +67,85 @@ void *runTimer( void *msTime )
        return NULL;
    }
 
-double accessTimer( int controlCode, char *timeStr )
+void initClock( SimClock *clock )
    {
-    static enum Bool running = False;
-    static int startSec = 0, endSec = 0, startUSec = 0, endUSec = 0;
-    static int lapSec = 0, lapUSec = 0;
+    clock->running = False;
+    clock->startSec = 0;
+    clock->startUSec = 0;
+    clock->virtualTime = False;
+    clock->nowUSec = 0;
+   }
+
+void advanceClock( SimClock *clock, int milliSeconds )
+   {
+    clock->nowUSec += (long) milliSeconds * 1000;
+   }
+
+void setClockTime( SimClock *clock, double seconds )
+   {
+    clock->nowUSec = (long) ( seconds * 1000000 + 0.5 );
+   }
+
+/* Starts the clock part way through a run, a real clock as though it
+   had been zeroed that long ago
+*/
+void resumeClock( SimClock *clock, double seconds )
+   {
+    struct timeval nowData;
+    long usecAgo = (long) ( seconds * 1000000 + 0.5 );
+
+    clock->running = True;
+    if( clock->virtualTime == True )
+       {
+        clock->nowUSec = usecAgo;
+        return;
+       }
+
+    gettimeofday( &nowData, NULL );
+    clock->startSec = nowData.tv_sec - usecAgo / 1000000;
+    clock->startUSec = nowData.tv_usec - usecAgo % 1000000;
+    if( clock->startUSec < 0 )
+       {
+        clock->startUSec += 1000000;
+        clock->startSec--;
+       }
+   }
+
+/* Worked out the same way a lap of the virtual clock is, so the time
+   compares equal once the clock gets there
+*/
+double clockTimeAfter( SimClock *clock, int milliSeconds )
+   {
+    return (double) ( clock->nowUSec + (long) milliSeconds * 1000 ) / 1000000;
+   }
+
+double accessTimer( SimClock *clock, int controlCode, char *timeStr )
+   {
+    int endSec = 0, endUSec = 0, lapSec = 0, lapUSec = 0;
     struct timeval startData, lapData, endData;
     double fpTime = 0.0;
 
+    if( clock->virtualTime == True )
+       {
+        if( controlCode == ZERO_TIMER )
+           {
+            clock->nowUSec = 0;
+           }
+        clock->running = controlCode != STOP_TIMER ? True : False;
+
+        timeToString( clock->nowUSec / 1000000, clock->nowUSec % 1000000,
+                      timeStr );
+        return (double) clock->nowUSec / 1000000;
+       }
+
     switch( controlCode )
        {
         case ZERO_TIMER:
            gettimeofday( &startData, NULL );
-           running = True;
+           clock->running = True;
 
-           startSec = startData.tv_sec;
-           startUSec = startData.tv_usec;
+           clock->startSec = startData.tv_sec;
+           clock->startUSec = startData.tv_usec;
 
            fpTime = 0.000000000;
            lapSec = 0.000000000;
@@ -92,15 +155,15 @@ double accessTimer( int controlCode, char *timeStr )
            break;
 
         case LAP_TIMER:
-           if( running == True )
+           if( clock->running == True )
               {
                gettimeofday( &lapData, NULL );
 
                lapSec = lapData.tv_sec;
                lapUSec = lapData.tv_usec;
 
-               fpTime = processTime( startSec, lapSec,
-                                                 startUSec, lapUSec, timeStr );
+               fpTime = processTime( clock->startSec, lapSec,
+                                     clock->startUSec, lapUSec, timeStr );
               }
 
            else
@@ -110,16 +173,16 @@ double accessTimer( int controlCode, char *timeStr )
            break;
 
         case STOP_TIMER:
-           if( running == True )
+           if( clock->running == True )
               {
                gettimeofday( &endData, NULL );
-               running = False;
+               clock->running = False;
 
                endSec = endData.tv_sec;
                endUSec = endData.tv_usec;
 
-               fpTime = processTime( startSec, endSec,
-                                                 startUSec, endUSec, timeStr );
+               fpTime = processTime( clock->startSec, endSec,
+                                     clock->startUSec, endUSec, timeStr );
               }
 
            // assume timer not running
@@ -33,10 +33,30 @@ enum Bool { False, True };
 extern const char RADIX_POINT;
 extern const char SPACE;
 
+// Data Structures  ///////////////////////////////////////////////////////////
+
+/* Each simulation keeps its own clock, so several can run at once
+   without sharing a start time. A virtual clock never reads the time of
+   day, it only moves when the simulation advances it.
+*/
+typedef struct SimClock
+   {
+    enum Bool running;
+    int startSec;
+    int startUSec;
+    enum Bool virtualTime;
+    long nowUSec;
+   } SimClock;
+
 // Function Prototyp  /////////////////////////////////////////////////////////
 
 void *runTimer( void *msTime );
-double accessTimer( int controlCode, char *timeStr );
+void initClock( SimClock *clock );
+double accessTimer( SimClock *clock, int controlCode, char *timeStr );
+void advanceClock( SimClock *clock, int milliSeconds );
+void setClockTime( SimClock *clock, double seconds );
+void resumeClock( SimClock *clock, double seconds );
+double clockTimeAfter( SimClock *clock, int milliSeconds );
 double processTime( double startSec, double endSec,
                            double startUSec, double endUSec, char *timeStr );
 void timeToString( int secTime, int uSecTime, char *timeStr );
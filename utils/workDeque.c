@@ -0,0 +1,169 @@
+// PROGRAMMER INFORMATION ////////////////////////////////////////////
+/**
+
+Secret Number: 764819
+
+*/
+// Code Implementation File Information /////////////////////////////
+/**
+* @file workDeque.c
+*
+* @brief Implementation file for workDeque code
+*
+* @details Implements all functions of the per-CPU work deque
+*/
+// Program Description/Support /////////////////////////////////////
+/*
+This program holds the processes assigned to one simulated CPU. Each
+operation takes the deque's own lock, so the owning CPU and any CPU
+stealing from it never see a half-moved entry.
+*/
+// Header Files ///////////////////////////////////////////////////
+//
+#include "workDeque.h"
+//
+// Global Constant Definitions ////////////////////////////////////
+//
+///// NONE
+//
+// Free Function Prototypes ///////////////////////////////////////
+//
+//==========================================================================
+/**
+* @brief Function initializes an empty deque
+*
+* @param[in] deque
+* A WorkDeque pointer
+*
+* @param[in] capacity
+* Number of PCBs the deque can hold before growing
+*/
+void initWorkDeque( WorkDeque *deque, int capacity )
+{
+	if( capacity < 1 )
+	{
+		capacity = 1;
+	}
+	pthread_mutex_init( &deque->lock, NULL );
+	deque->head = 0;
+	deque->count = 0;
+	deque->capacity = capacity;
+	deque->blocks = malloc( sizeof( ProcessControlBlock * ) * capacity );
+}
+
+//==========================================================================
+/**
+* @brief Function frees the deque's storage, the PCBs are not freed
+*
+* @param[in] deque
+* A WorkDeque pointer
+*/
+void freeWorkDeque( WorkDeque *deque )
+{
+	pthread_mutex_destroy( &deque->lock );
+	free( deque->blocks );
+	deque->blocks = NULL;
+	deque->count = 0;
+}
+
+//==========================================================================
+/**
+* @brief Function adds a PCB at the tail of the deque
+*
+* @details Function doubles the ring buffer, unrolling it to start at
+*   slot zero, when it is full.
+*
+* @param[in] deque
+* A WorkDeque pointer
+*
+* @param[in] pcb
+* The PCB to add
+*/
+void pushWork( WorkDeque *deque, ProcessControlBlock *pcb )
+{
+	ProcessControlBlock **grown;
+	int index;
+
+	pthread_mutex_lock( &deque->lock );
+
+	if( deque->count == deque->capacity )
+	{
+		grown = malloc( sizeof( ProcessControlBlock * ) *
+		                deque->capacity * 2 );
+		for( index = 0; index < deque->count; index++ )
+		{
+			grown[ index ] =
+				deque->blocks[ ( deque->head + index ) % deque->capacity ];
+		}
+		free( deque->blocks );
+		deque->blocks = grown;
+		deque->head = 0;
+		deque->capacity *= 2;
+	}
+
+	deque->blocks[ ( deque->head + deque->count ) % deque->capacity ] = pcb;
+	deque->count++;
+
+	pthread_mutex_unlock( &deque->lock );
+}
+
+//==========================================================================
+/**
+* @brief Function removes the PCB at the head, used by the owning CPU
+*
+* @param[in] deque
+* A WorkDeque pointer
+*
+* @return the oldest PCB, or NULL if the deque is empty
+*/
+ProcessControlBlock *takeWork( WorkDeque *deque )
+{
+	ProcessControlBlock *pcb = NULL;
+
+	pthread_mutex_lock( &deque->lock );
+
+	if( deque->count > 0 )
+	{
+		pcb = deque->blocks[ deque->head ];
+		deque->head = ( deque->head + 1 ) % deque->capacity;
+		deque->count--;
+	}
+
+	pthread_mutex_unlock( &deque->lock );
+	return pcb;
+}
+
+//==========================================================================
+/**
+* @brief Function removes the PCB at the tail, used by an idle CPU
+*
+* @details Stealing from the opposite end to the owner takes the work the
+*   owner would have reached last.
+*
+* @param[in] deque
+* A WorkDeque pointer
+*
+* @return the newest PCB, or NULL if the deque is empty
+*/
+ProcessControlBlock *stealWork( WorkDeque *deque )
+{
+	ProcessControlBlock *pcb = NULL;
+
+	pthread_mutex_lock( &deque->lock );
+
+	if( deque->count > 0 )
+	{
+		deque->count--;
+		pcb = deque->blocks[ ( deque->head + deque->count ) %
+		                     deque->capacity ];
+	}
+
+	pthread_mutex_unlock( &deque->lock );
+	return pcb;
+}
+
+//==========================================================================
+// Terminating Precompiler Directives ///////////////////////////////
+//
+///// NONE
+//
@@ -0,0 +1,71 @@
+// PROGRAMMER INFORMATION ////////////////////////////////////////////
+/**
+
+Secret Number: 764819
+
+*/
+// Header File Information /////////////////////////////////////
+/**
+* @file workDeque.h
+*
+* @brief Header file for workDeque code
+*
+* @details Specifies functions, constants, and other information
+* related to the per-CPU work deque
+*/
+// Precompiler Directives //////////////////////////////////////////
+//
+#ifndef WORK_DEQUE_H
+#define WORK_DEQUE_H
+//
+// Header Files ///////////////////////////////////////////////////
+//
+#include <pthread.h>
+#include <stdlib.h>
+#include "processList.h"
+//
+// Global Constant Definitions ////////////////////////////////////
+//
+///// NONE
+//
+// Data Structure Definitions (structs, enums, etc.)////////////////
+//
+/*
+  A ring buffer of PCBs. The owning CPU takes from the head, in the order
+  work was pushed, and idle CPUs steal from the tail.
+*/
+typedef struct WorkDeque
+{
+	pthread_mutex_t lock;
+	int head;
+	int count;
+	int capacity;
+	ProcessControlBlock **blocks;
+} WorkDeque;
+//
+// Free Function Prototypes ///////////////////////////////////////
+//
+//==========================================================================
+
+void initWorkDeque( WorkDeque *deque, int capacity );
+
+//==========================================================================
+
+void freeWorkDeque( WorkDeque *deque );
+
+//==========================================================================
+
+void pushWork( WorkDeque *deque, ProcessControlBlock *pcb );
+
+//==========================================================================
+
+ProcessControlBlock *takeWork( WorkDeque *deque );
+
+//==========================================================================
+
+ProcessControlBlock *stealWork( WorkDeque *deque );
+
+// Terminating Precompiler Directives ///////////////////////////////
+//
+#endif // WORK_DEQUE_H
+//